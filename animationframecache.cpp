@@ -0,0 +1,64 @@
+#include "animationframecache.h"
+
+#include <QImage>
+#include <QImageReader>
+#include <QDebug>
+
+QHash<QString, QWeakPointer<const AnimationFrames>> &AnimationFrameCache::entries() {
+    static QHash<QString, QWeakPointer<const AnimationFrames>> cache;
+    return cache;
+}
+
+QSharedPointer<const AnimationFrames> AnimationFrameCache::acquire(const QString &filePath, const QSize &deviceSize) {
+    const QString key = QString("%1@%2x%3").arg(filePath).arg(deviceSize.width()).arg(deviceSize.height());
+
+    auto &cache = entries();
+    QSharedPointer<const AnimationFrames> frames = cache.value(key).toStrongRef();
+    if (frames) return frames;
+
+    frames = decode(filePath, deviceSize);
+    if (frames) {
+        cache.insert(key, frames.toWeakRef());
+    } else {
+        cache.remove(key);
+    }
+
+    // Drop entries whose animations have been released in the meantime.
+    for (auto it = cache.begin(); it != cache.end();) {
+        it = it.value().isNull() ? cache.erase(it) : std::next(it);
+    }
+    return frames;
+}
+
+QSharedPointer<const AnimationFrames> AnimationFrameCache::decode(const QString &filePath, const QSize &deviceSize) {
+    QImageReader reader(filePath);
+    if (!reader.canRead()) {
+        qWarning() << "AnimationFrameCache: Cannot read animation" << filePath << "Error:" << reader.errorString();
+        return {};
+    }
+
+    // Request the target size from the decoder when the format supports it;
+    // otherwise frames are decoded once at full size and scaled down right away.
+    const bool decoderScales = deviceSize.isValid() && reader.supportsOption(QImageIOHandler::ScaledSize);
+    if (decoderScales) reader.setScaledSize(deviceSize);
+
+    auto frames = QSharedPointer<AnimationFrames>::create();
+    frames->deviceSize = deviceSize;
+    while (reader.canRead()) {
+        QImage image = reader.read();
+        if (image.isNull()) break;
+        if (!decoderScales && deviceSize.isValid() && image.size() != deviceSize) {
+            image = image.scaled(deviceSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation); // Label uses scaled contents
+        }
+        const int delay = reader.nextImageDelay();
+        frames->frames.append(QPixmap::fromImage(image));
+        frames->delaysMs.append(delay > 0 ? delay : DEFAULT_FRAME_DELAY_MS);
+    }
+
+    if (frames->frames.isEmpty()) {
+        qWarning() << "AnimationFrameCache: No frames decoded from" << filePath << "Error:" << reader.errorString();
+        return {};
+    }
+    qDebug() << "AnimationFrameCache: Decoded" << frames->frames.size() << "frame(s) of" << filePath << "at" << deviceSize;
+    return frames;
+}
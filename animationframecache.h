@@ -0,0 +1,34 @@
+#ifndef ANIMATIONFRAMECACHE_H
+#define ANIMATIONFRAMECACHE_H
+
+#include <QString>
+#include <QSize>
+#include <QList>
+#include <QPixmap>
+#include <QHash>
+#include <QSharedPointer>
+#include <QWeakPointer>
+
+// One decoded animation, with every frame already scaled to the size it is drawn at.
+struct AnimationFrames {
+    QList<QPixmap> frames;
+    QList<int> delaysMs;
+    QSize deviceSize;
+};
+
+// Process-wide cache of decoded animations, keyed by file and device-pixel size.
+// The cache only holds weak references: an animation stays decoded while some
+// label is showing it and is released as soon as the last user lets go.
+// GUI thread only (frames are QPixmaps).
+class AnimationFrameCache {
+public:
+    static QSharedPointer<const AnimationFrames> acquire(const QString &filePath, const QSize &deviceSize);
+
+private:
+    static QSharedPointer<const AnimationFrames> decode(const QString &filePath, const QSize &deviceSize);
+    static QHash<QString, QWeakPointer<const AnimationFrames>> &entries();
+
+    static const int DEFAULT_FRAME_DELAY_MS = 100;
+};
+
+#endif // ANIMATIONFRAMECACHE_H
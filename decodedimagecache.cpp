@@ -0,0 +1,221 @@
+#include "decodedimagecache.h"
+#include "startuptrace.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSharedPointer>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QDateTime>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+const quint32 CACHE_MAGIC = 0x43494453; // "SDIC" read back in native byte order
+const QString CACHE_FILE_NAME = QStringLiteral("decoded-images.cache");
+const QString PENDING_SUFFIX = QStringLiteral(".new");
+
+// The file is native byte order and only ever read by the machine that wrote it.
+struct FileHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 entryCount;
+    quint32 byteOrder;          // QSysInfo::ByteOrder of the writer
+};
+
+struct EntryRecord {
+    qint64 keyOffset;           // UTF-8 key: "<source path>@<width>x<height>"
+    qint64 pixelOffset;         // Aligned to PIXEL_ALIGNMENT
+    qint64 sourceModifiedMs;
+    qint64 sourceSize;
+    qint32 keyBytes;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;              // QImage::Format
+    qint32 reserved;
+};
+static_assert(sizeof(FileHeader) == 16 && sizeof(EntryRecord) == 56, "Cache records must not change size silently");
+
+bool isCachedFormat(int format) {
+    return format == QImage::Format_ARGB32_Premultiplied || format == QImage::Format_RGB32;
+}
+
+void releaseMapping(void *mapping) {
+    delete static_cast<QSharedPointer<QFile> *>(mapping);
+}
+}
+
+DecodedImageCache &DecodedImageCache::shared() {
+    static DecodedImageCache cache(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath(CACHE_FILE_NAME));
+    return cache;
+}
+
+DecodedImageCache::DecodedImageCache(const QString &fileName)
+    : m_fileName(fileName),
+      m_dirty(false)
+{
+    load();
+}
+
+QString DecodedImageCache::keyFor(const QString &sourcePath, const QSize &deviceSize) {
+    return QString("%1@%2x%3").arg(QDir::cleanPath(sourcePath)).arg(deviceSize.width()).arg(deviceSize.height());
+}
+
+bool DecodedImageCache::sourceMatches(const Entry &entry) {
+    const QFileInfo info(entry.sourcePath);
+    return info.exists() && info.size() == entry.sourceSize && info.lastModified().toMSecsSinceEpoch() == entry.sourceModifiedMs;
+}
+
+void DecodedImageCache::load() {
+    StartupTrace::Zone zone("Map decoded image cache", "loader");
+    // A cache written last time replaces the mapped one only now, while
+    // nothing maps it; Windows refuses to replace a mapped file.
+    const QString pendingName = m_fileName + PENDING_SUFFIX;
+    if (QFile::exists(pendingName)) {
+        QFile::remove(m_fileName);
+        if (!QFile::rename(pendingName, m_fileName)) qWarning() << "DecodedImageCache: Could not replace" << m_fileName;
+    }
+
+    auto file = QSharedPointer<QFile>::create(m_fileName);
+    if (!file->open(QIODevice::ReadOnly)) return; // Cold start
+    const qint64 fileSize = file->size();
+    if (fileSize < qint64(sizeof(FileHeader))) return;
+    const uchar *data = file->map(0, fileSize);
+    if (!data) {
+        qWarning() << "DecodedImageCache: Cannot map" << m_fileName << ":" << file->errorString();
+        return;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != CACHE_MAGIC || header.version != FORMAT_VERSION || header.byteOrder != quint32(QSysInfo::ByteOrder)
+        || qint64(sizeof(FileHeader)) + qint64(header.entryCount) * qint64(sizeof(EntryRecord)) > fileSize) {
+        qDebug() << "DecodedImageCache: Ignoring" << m_fileName << "(other format version or damaged).";
+        return;
+    }
+
+    QHash<QString, Entry> entries;
+    for (quint32 i = 0; i < header.entryCount; ++i) {
+        EntryRecord record;
+        std::memcpy(&record, data + sizeof(FileHeader) + i * sizeof(EntryRecord), sizeof(record));
+        const qint64 pixelBytes = qint64(record.bytesPerLine) * record.height;
+        const bool valid = isCachedFormat(record.format) && record.width > 0 && record.height > 0
+                           && record.bytesPerLine >= record.width * 4 && record.keyBytes > 0
+                           && record.keyOffset >= 0 && record.keyOffset + record.keyBytes <= fileSize
+                           && record.pixelOffset >= 0 && record.pixelOffset % PIXEL_ALIGNMENT == 0
+                           && record.pixelOffset + pixelBytes <= fileSize;
+        if (!valid) {
+            qWarning() << "DecodedImageCache: Damaged entry in" << m_fileName << "; ignoring the cache.";
+            return;
+        }
+        const QString key = QString::fromUtf8(reinterpret_cast<const char *>(data + record.keyOffset), record.keyBytes);
+
+        Entry entry;
+        entry.sourcePath = key.left(key.lastIndexOf(QLatin1Char('@')));
+        entry.sourceModifiedMs = record.sourceModifiedMs;
+        entry.sourceSize = record.sourceSize;
+        // Read-only image over the mapping; each image keeps the mapping alive.
+        entry.image = QImage(data + record.pixelOffset, record.width, record.height, record.bytesPerLine,
+                             static_cast<QImage::Format>(record.format), releaseMapping, new QSharedPointer<QFile>(file));
+        entries.insert(key, entry);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_entries.swap(entries);
+    qDebug() << "DecodedImageCache: Mapped" << m_entries.size() << "image(s) from" << m_fileName;
+}
+
+QImage DecodedImageCache::find(const QString &sourcePath, const QSize &deviceSize) const {
+    Entry entry;
+    {
+        QMutexLocker locker(&m_mutex);
+        const auto it = m_entries.constFind(keyFor(sourcePath, deviceSize));
+        if (it == m_entries.constEnd()) return QImage();
+        entry = it.value();
+    }
+    return sourceMatches(entry) ? entry.image : QImage();
+}
+
+void DecodedImageCache::insert(const QString &sourcePath, const QSize &deviceSize, const QImage &image) {
+    if (image.isNull()) return;
+    const QFileInfo info(sourcePath);
+    if (!info.exists()) return;
+
+    Entry entry;
+    entry.sourcePath = QDir::cleanPath(sourcePath);
+    entry.sourceModifiedMs = info.lastModified().toMSecsSinceEpoch();
+    entry.sourceSize = info.size();
+    entry.image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32);
+
+    QMutexLocker locker(&m_mutex);
+    m_entries.insert(keyFor(sourcePath, deviceSize), entry);
+    m_dirty = true;
+}
+
+bool DecodedImageCache::write() {
+    QHash<QString, Entry> entries;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_dirty) return true;
+        entries = m_entries;
+        m_dirty = false;
+    }
+    for (auto it = entries.begin(); it != entries.end();) {
+        it = sourceMatches(it.value()) ? std::next(it) : entries.erase(it); // Stale entries are not carried over
+    }
+
+    // Lay out header, records, keys, then the pixel blocks.
+    QList<QByteArray> keys;
+    QList<EntryRecord> records;
+    qint64 offset = sizeof(FileHeader) + qint64(entries.size()) * sizeof(EntryRecord);
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+        const QByteArray key = it.key().toUtf8();
+        EntryRecord record = {};
+        record.keyOffset = offset;
+        record.keyBytes = key.size();
+        offset += key.size();
+        keys.append(key);
+        records.append(record);
+    }
+    int index = 0;
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it, ++index) {
+        const QImage &image = it.value().image;
+        offset = (offset + PIXEL_ALIGNMENT - 1) / PIXEL_ALIGNMENT * PIXEL_ALIGNMENT;
+        EntryRecord &record = records[index];
+        record.pixelOffset = offset;
+        record.sourceModifiedMs = it.value().sourceModifiedMs;
+        record.sourceSize = it.value().sourceSize;
+        record.width = image.width();
+        record.height = image.height();
+        record.bytesPerLine = int(image.bytesPerLine());
+        record.format = image.format();
+        offset += image.sizeInBytes();
+    }
+
+    QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+    QSaveFile file(m_fileName + PENDING_SUFFIX);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "DecodedImageCache: Cannot write" << file.fileName() << ":" << file.errorString();
+        return false;
+    }
+    const FileHeader header = { CACHE_MAGIC, FORMAT_VERSION, quint32(entries.size()), quint32(QSysInfo::ByteOrder) };
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (const EntryRecord &record : records) file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    for (const QByteArray &key : keys) file.write(key);
+    index = 0;
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it, ++index) {
+        const qint64 padding = records.at(index).pixelOffset - file.pos();
+        if (padding > 0) file.write(QByteArray(padding, '\0'));
+        const QImage &image = it.value().image;
+        file.write(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+    }
+    if (!file.commit()) {
+        qWarning() << "DecodedImageCache: Cannot write" << file.fileName() << ":" << file.errorString();
+        return false;
+    }
+    qDebug() << "DecodedImageCache: Saved" << entries.size() << "image(s) for the next start," << offset << "bytes.";
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef DECODEDIMAGECACHE_H
+#define DECODEDIMAGECACHE_H
+
+#include <QString>
+#include <QSize>
+#include <QImage>
+#include <QHash>
+#include <QMutex>
+
+// Process-wide cache of startup images, already decoded, scaled and
+// premultiplied, kept in one file under the cache location. Warm starts map
+// the file and hand out QImages that point straight into the mapping, so a
+// hit costs a stat of the source file and nothing else. Entries are keyed by
+// source path and decoded size (invalid for the file's own size) and dropped
+// once the source's size or modification time changes. Safe to use from any
+// thread.
+class DecodedImageCache {
+public:
+    static DecodedImageCache &shared();
+
+    QImage find(const QString &sourcePath, const QSize &deviceSize) const; // Null on a miss
+    void insert(const QString &sourcePath, const QSize &deviceSize, const QImage &image);
+    bool write(); // Saves new entries, if any, for the next start
+
+    static const quint32 FORMAT_VERSION = 1;
+    static const int PIXEL_ALIGNMENT = 64;
+
+private:
+    struct Entry {
+        QString sourcePath;
+        qint64 sourceModifiedMs = 0;
+        qint64 sourceSize = 0;
+        QImage image;
+    };
+
+    explicit DecodedImageCache(const QString &fileName);
+    void load();
+    static bool sourceMatches(const Entry &entry);
+    static QString keyFor(const QString &sourcePath, const QSize &deviceSize);
+
+    QString m_fileName;
+    mutable QMutex m_mutex;         // Guards m_entries and m_dirty
+    QHash<QString, Entry> m_entries;
+    bool m_dirty;
+};
+
+#endif // DECODEDIMAGECACHE_H
@@ -0,0 +1,90 @@
+#ifndef DIRECTORYCANDIDATE_H
+#define DIRECTORYCANDIDATE_H
+
+#include <QString>
+#include <QStringView>
+#include "projectinfo.h"
+
+enum class ProjectType : quint8 {
+    None,
+    SoftudioPotential,
+    Cmake,
+    NpmYarn,
+    GitRepo,
+    VsSolution,
+    Unreal,
+    CsharpProject,
+    Make,
+    Maven,
+    Gradle,
+    PythonSetup,
+    SourceDir,
+    IncludeDir,
+    LibraryDir
+};
+
+// Type string stored in ProjectInfo::type ("softudio_potential", "heuristic_cmake", ...).
+inline QString projectTypeKey(ProjectType type) {
+    switch (type) {
+    case ProjectType::None:              return QStringLiteral("unknown");
+    case ProjectType::SoftudioPotential: return QStringLiteral("softudio_potential");
+    case ProjectType::Cmake:             return QStringLiteral("heuristic_cmake");
+    case ProjectType::NpmYarn:           return QStringLiteral("heuristic_npm_yarn");
+    case ProjectType::GitRepo:           return QStringLiteral("heuristic_git_repo");
+    case ProjectType::VsSolution:        return QStringLiteral("heuristic_vs_solution");
+    case ProjectType::Unreal:            return QStringLiteral("heuristic_unreal");
+    case ProjectType::CsharpProject:     return QStringLiteral("heuristic_csharp_proj");
+    case ProjectType::Make:              return QStringLiteral("heuristic_make");
+    case ProjectType::Maven:             return QStringLiteral("heuristic_maven");
+    case ProjectType::Gradle:            return QStringLiteral("heuristic_gradle");
+    case ProjectType::PythonSetup:       return QStringLiteral("heuristic_python_setup");
+    case ProjectType::SourceDir:         return QStringLiteral("heuristic_source_dir");
+    case ProjectType::IncludeDir:        return QStringLiteral("heuristic_include_dir");
+    case ProjectType::LibraryDir:        return QStringLiteral("heuristic_library_dir");
+    }
+    return QStringLiteral("unknown");
+}
+
+// What the scan walk builds for every directory it visits. The name is a view
+// into the path and the type an enum; a full ProjectInfo is only materialized
+// for directories that turn out to be projects.
+struct DirectoryCandidate {
+    QString path;               // Native separators
+    qsizetype nameOffset = 0;
+    qsizetype nameLength = 0;
+    ProjectType type = ProjectType::None;
+
+    DirectoryCandidate() = default;
+
+    explicit DirectoryCandidate(const QString &nativePath)
+        : path(nativePath) {
+        auto isSeparator = [](QChar c) { return c == QLatin1Char('/') || c == QLatin1Char('\\'); };
+        qsizetype end = path.size();
+        while (end > 0 && isSeparator(path.at(end - 1))) --end;
+        qsizetype start = end;
+        while (start > 0 && !isSeparator(path.at(start - 1))) --start;
+        if (end > start) {
+            nameOffset = start;
+            nameLength = end - start;
+        } else { // Filesystem root: use the path itself
+            nameOffset = 0;
+            nameLength = path.size();
+        }
+    }
+
+    QStringView name() const { return QStringView(path).mid(nameOffset, nameLength); }
+    bool isProject() const { return type != ProjectType::None; }
+    bool isSoftudio() const { return type == ProjectType::SoftudioPotential; }
+
+    ProjectInfo toProjectInfo() const {
+        ProjectInfo info; // Default constructor: no filesystem access
+        info.path = path;
+        info.name = name().toString();
+        info.type = projectTypeKey(type);
+        info.isSoftudioProjectFlag = isSoftudio();
+        info.heuristicallyFound = isProject() && !isSoftudio();
+        return info;
+    }
+};
+
+#endif // DIRECTORYCANDIDATE_H
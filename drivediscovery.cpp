@@ -0,0 +1,286 @@
+#include "drivediscovery.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStorageInfo>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+namespace {
+// Last completed discovery, shared by every dialog opened in this process (GUI thread only).
+QStringList s_cachedLocations;
+bool s_hasCachedLocations = false;
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACX)
+bool isMacOS() {
+    const QString product = QSysInfo::productType().toLower();
+    return product == "osx" || product == "macos";
+}
+#endif
+}
+
+DriveDiscovery::DriveDiscovery(QObject *parent)
+    : QObject(parent),
+      m_running(false),
+      m_candidatesReceived(false)
+{
+    connect(&m_candidateWatcher, &QFutureWatcher<QList<Candidate>>::finished,
+            this, &DriveDiscovery::onCandidatesReady);
+
+    m_enumerationDeadline.setSingleShot(true);
+    connect(&m_enumerationDeadline, &QTimer::timeout, this, &DriveDiscovery::onEnumerationDeadline);
+}
+
+DriveDiscovery::~DriveDiscovery()
+{
+    // Probes never reference 'this', so a hung statfs simply finishes (or not) on its own.
+    m_enumerationDeadline.stop();
+}
+
+QThreadPool *DriveDiscovery::probePool() {
+    // Deliberately leaked: a probe stuck in statfs on a dead mount can never be joined,
+    // and a static QThreadPool would block process exit waiting for it. It is also kept
+    // apart from the global pool so stuck probes cannot starve project validation.
+    static QThreadPool *pool = []() {
+        QThreadPool *p = new QThreadPool();
+        p->setMaxThreadCount(16);
+        p->setExpiryTimeout(5000);
+        return p;
+    }();
+    return pool;
+}
+
+bool DriveDiscovery::hasCachedLocations() {
+    return s_hasCachedLocations;
+}
+
+QStringList DriveDiscovery::cachedLocations() {
+    return s_cachedLocations;
+}
+
+void DriveDiscovery::start() {
+    if (m_running) return;
+
+    m_running = true;
+    m_candidatesReceived = false;
+    m_pendingProbes.clear();
+    m_locations.clear();
+    m_unresponsive.clear();
+
+    m_candidateWatcher.setFuture(QtConcurrent::run(probePool(), &DriveDiscovery::enumerateCandidates));
+    m_enumerationDeadline.start(ENUMERATION_DEADLINE_MS);
+}
+
+void DriveDiscovery::onCandidatesReady() {
+    if (!m_running || m_candidatesReceived) return; // Already given up on enumeration
+    m_enumerationDeadline.stop();
+    m_candidatesReceived = true;
+
+    const QList<Candidate> candidates = m_candidateWatcher.result();
+    qDebug() << "DriveDiscovery: Probing" << candidates.size() << "candidate location(s).";
+    for (const Candidate &candidate : candidates) {
+        startProbe(candidate);
+    }
+    finishIfSettled();
+}
+
+void DriveDiscovery::onEnumerationDeadline() {
+    if (!m_running || m_candidatesReceived) return;
+    qWarning() << "DriveDiscovery: Enumerating mount points timed out after" << ENUMERATION_DEADLINE_MS << "ms.";
+    m_candidatesReceived = true;
+    finishIfSettled();
+}
+
+void DriveDiscovery::startProbe(const Candidate &candidate) {
+    if (m_pendingProbes.contains(candidate.path)) return; // Same mount listed twice
+    m_pendingProbes.insert(candidate.path);
+
+    auto *watcher = new QFutureWatcher<QString>(this);
+    auto *deadline = new QTimer(watcher);
+    deadline->setSingleShot(true);
+
+    const QString candidatePath = candidate.path;
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, deadline, candidatePath]() {
+        deadline->stop();
+        if (m_pendingProbes.contains(candidatePath)) {
+            const QString location = watcher->result();
+            if (!location.isEmpty() && !m_locations.contains(location)) {
+                m_locations.insert(location);
+                emit locationDiscovered(location);
+            }
+            settleProbe(candidatePath);
+        }
+        watcher->deleteLater();
+    });
+    connect(deadline, &QTimer::timeout, this, [this, candidatePath]() {
+        if (!m_pendingProbes.contains(candidatePath)) return;
+        qWarning() << "DriveDiscovery: Mount" << candidatePath << "did not answer within" << PROBE_DEADLINE_MS << "ms.";
+        m_unresponsive.append(QDir::toNativeSeparators(candidatePath));
+        emit locationUnresponsive(QDir::toNativeSeparators(candidatePath));
+        // The watcher stays alive until the probe returns (if ever), then deletes itself.
+        settleProbe(candidatePath);
+    });
+
+    watcher->setFuture(QtConcurrent::run(probePool(), &DriveDiscovery::probeCandidate, candidate));
+    deadline->start(PROBE_DEADLINE_MS);
+}
+
+void DriveDiscovery::settleProbe(const QString &candidatePath) {
+    m_pendingProbes.remove(candidatePath);
+    finishIfSettled();
+}
+
+void DriveDiscovery::finishIfSettled() {
+    if (!m_running || !m_candidatesReceived || !m_pendingProbes.isEmpty()) return;
+
+    if (m_locations.isEmpty()) {
+        // Same fallback as before: offer home (or the working directory) rather than nothing.
+        QString homePath = QStandardPaths::writableLocation(QStandardPaths::HomeLocation);
+        QFileInfo fiHome(homePath);
+        QString fallback = (fiHome.exists() && fiHome.isDir() && fiHome.isReadable())
+                               ? QDir::toNativeSeparators(fiHome.canonicalFilePath())
+                               : QDir::toNativeSeparators(QDir::currentPath());
+        m_locations.insert(fallback);
+        emit locationDiscovered(fallback);
+    }
+
+    QStringList locations = m_locations.values();
+    std::sort(locations.begin(), locations.end());
+    s_cachedLocations = locations;
+    s_hasCachedLocations = true;
+    m_running = false;
+
+    qDebug() << "DriveDiscovery: Detected scannable locations:" << locations << "Unresponsive:" << m_unresponsive;
+    emit discoveryFinished(locations);
+}
+
+QList<DriveDiscovery::Candidate> DriveDiscovery::enumerateCandidates() {
+    QList<Candidate> candidates;
+
+#if defined(Q_OS_WIN)
+    DWORD logicalDrives = GetLogicalDrives();
+    for (int i = 0; i < 26; ++i) {
+        if ((logicalDrives >> i) & 1) {
+            candidates.append({QString(QChar('A' + i)) + ":\\", QString(), CandidateKind::LogicalDrive});
+        }
+    }
+    if (!(logicalDrives & (1 << 2))) {
+        candidates.append({"C:\\", QString(), CandidateKind::LogicalDrive});
+    }
+
+#elif defined(Q_OS_LINUX) || defined(Q_OS_MACX)
+    QStringList stdRoots;
+    stdRoots << QDir::rootPath() << QStandardPaths::writableLocation(QStandardPaths::HomeLocation);
+    if (isMacOS()) stdRoots << "/Users";
+    for (const QString &rPath : stdRoots) {
+        candidates.append({rPath, QString(), CandidateKind::StandardRoot});
+    }
+
+    QStringList commonMountParents;
+    commonMountParents << "/mnt" << "/media" << "/run/media";
+    if (isMacOS()) commonMountParents << "/Volumes";
+
+    for (const QString &parentMount : commonMountParents) {
+        // Names only: whether each child is a live mount is decided by its own probe.
+        const QStringList children = QDir(parentMount).entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::System | QDir::Hidden, QDir::Name);
+        for (const QString &child : children) {
+            candidates.append({parentMount + "/" + child, QString(), CandidateKind::MountParentEntry});
+        }
+    }
+
+#if defined(Q_OS_LINUX)
+    QFile procMounts("/proc/mounts");
+    if (procMounts.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream in(&procMounts);
+        const QStringList excludedFsTypes = {"proc", "sysfs", "devtmpfs", "devpts", "tmpfs", "securityfs",
+                                             "cgroup", "pstore", "debugfs", "hugetlbfs", "mqueue",
+                                             "fuse.gvfsd-fuse", "fusectl", "tracefs", "binfmt_misc",
+                                             "configfs", "efivarfs", "snapfuse", "squashfs", "autofs", "rpc_pipefs", "overlay", "nsfs"};
+        const QStringList excludedPathPrefixes = {"/dev", "/proc", "/sys", "/run/user", "/run/lock", "/boot", "/snap", "/tmp",
+                                                  "/var/lib/docker", "/var/lib/snapd", "/var/tmp"};
+        while (!in.atEnd()) {
+            const QStringList parts = in.readLine().trimmed().split(' ', Qt::SkipEmptyParts);
+            if (parts.size() < 3) continue;
+            const QString &device = parts[0];
+            const QString &mountPoint = parts[1];
+            const QString &fsType = parts[2];
+
+            bool isExcluded = excludedFsTypes.contains(fsType);
+            if (device.startsWith("/dev/loop") || device.startsWith("/dev/snap")) isExcluded = true; // Squashfs often via loop
+            for (const QString &prefix : excludedPathPrefixes) {
+                if (mountPoint.startsWith(prefix)) {
+                    isExcluded = true;
+                    break;
+                }
+            }
+            if (!isExcluded && mountPoint.startsWith("/")) {
+                candidates.append({mountPoint, fsType, CandidateKind::MountTableEntry});
+            }
+        }
+        procMounts.close();
+    }
+#endif // Q_OS_LINUX
+
+#else // Other OS (very basic fallback)
+    const QFileInfoList qDrives = QDir::drives();
+    for (const QFileInfo &drive : qDrives) {
+        candidates.append({drive.filePath(), QString(), CandidateKind::StandardRoot});
+    }
+#endif
+
+    return candidates;
+}
+
+QString DriveDiscovery::probeCandidate(const Candidate &candidate) {
+    // Runs on probePool(); any of these calls may block for a long time on a dead mount.
+    switch (candidate.kind) {
+    case CandidateKind::LogicalDrive: {
+#if defined(Q_OS_WIN)
+        UINT driveType = GetDriveTypeW(reinterpret_cast<LPCWSTR>(candidate.path.utf16()));
+        if (driveType != DRIVE_FIXED && driveType != DRIVE_REMOVABLE && driveType != DRIVE_REMOTE) return QString();
+#endif
+        QFileInfo fileInfo(candidate.path);
+        if (fileInfo.exists() && fileInfo.isReadable()) return QDir::toNativeSeparators(candidate.path);
+        return QString();
+    }
+    case CandidateKind::StandardRoot: {
+        QFileInfo fi(candidate.path);
+        if (fi.exists() && fi.isDir() && fi.isReadable()) return QDir::toNativeSeparators(fi.canonicalFilePath());
+        return QString();
+    }
+    case CandidateKind::MountParentEntry: {
+        QFileInfo entry(candidate.path);
+        if (!entry.isReadable()) return QString();
+        // QStorageInfo is better for checking if it's a real mount
+        QStorageInfo storage(entry.filePath());
+        if (storage.isValid() && storage.isReady() && !storage.rootPath().isEmpty()) {
+            return QDir::toNativeSeparators(storage.rootPath());
+        } else if (entry.isDir()) { // Fallback for older Qt or non-obvious mounts
+            return QDir::toNativeSeparators(entry.canonicalFilePath());
+        }
+        return QString();
+    }
+    case CandidateKind::MountTableEntry: {
+        QFileInfo fi(candidate.path);
+        QStorageInfo storage(candidate.path);
+        if (storage.isValid() && storage.isReady() && !storage.isReadOnly()
+            && (storage.bytesTotal() > 0 || candidate.fsType.contains("nfs") || candidate.fsType.contains("cifs"))) { // Check if real storage
+            return QDir::toNativeSeparators(storage.rootPath());
+        } else if (fi.exists() && fi.isDir() && fi.isReadable() && !storage.isValid()) { // Fallback for non-storageinfo recognized mounts
+            return QDir::toNativeSeparators(fi.canonicalFilePath());
+        }
+        return QString();
+    }
+    }
+    return QString();
+}
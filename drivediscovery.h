@@ -0,0 +1,74 @@
+#ifndef DRIVEDISCOVERY_H
+#define DRIVEDISCOVERY_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QSet>
+#include <QFutureWatcher>
+#include <QTimer>
+
+class QThreadPool;
+
+// Finds scannable drives/mount points without touching the filesystem on the GUI thread.
+// Candidates are enumerated in the background, then every candidate is probed as its own
+// task with a deadline: a dead NFS/CIFS mount blocks only its own probe and is reported
+// as unresponsive instead of freezing the dialog. Results are cached for the process
+// lifetime so reopening the scanner shows the last list immediately.
+class DriveDiscovery : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DriveDiscovery(QObject *parent = nullptr);
+    ~DriveDiscovery() override;
+
+    void start();
+    bool isRunning() const { return m_running; }
+
+    static bool hasCachedLocations();
+    static QStringList cachedLocations();
+
+signals:
+    void locationDiscovered(const QString &path);
+    void locationUnresponsive(const QString &path);
+    void discoveryFinished(const QStringList &locations);
+
+private slots:
+    void onCandidatesReady();
+    void onEnumerationDeadline();
+
+private:
+    enum class CandidateKind {
+        StandardRoot,       // "/", home, /Users: plain directory checks
+        MountParentEntry,   // Child of /mnt, /media, /run/media, /Volumes
+        MountTableEntry,    // Line from /proc/mounts
+        LogicalDrive        // Windows drive letter
+    };
+    struct Candidate {
+        QString path;
+        QString fsType;
+        CandidateKind kind = CandidateKind::StandardRoot;
+    };
+
+    void startProbe(const Candidate &candidate);
+    void settleProbe(const QString &candidatePath);
+    void finishIfSettled();
+
+    static QList<Candidate> enumerateCandidates();
+    static QString probeCandidate(const Candidate &candidate);
+    static QThreadPool *probePool();
+
+    QFutureWatcher<QList<Candidate>> m_candidateWatcher;
+    QTimer m_enumerationDeadline;
+    QSet<QString> m_pendingProbes;
+    QSet<QString> m_locations;
+    QStringList m_unresponsive;
+    bool m_running;
+    bool m_candidatesReceived;
+
+    const int ENUMERATION_DEADLINE_MS = 3000;
+    const int PROBE_DEADLINE_MS = 2000;
+};
+
+#endif // DRIVEDISCOVERY_H
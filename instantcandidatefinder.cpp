@@ -0,0 +1,154 @@
+#include "instantcandidatefinder.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QSet>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QXmlStreamReader>
+#include <QDebug>
+
+namespace {
+const int RECENT_ANCESTOR_LEVELS = 3; // How far up from a recent file to look for a project root
+}
+
+InstantCandidateFinder::InstantCandidateFinder(const QStringList &nestedPathParts)
+    : m_nestedMarker('/' + nestedPathParts.join('/') + '/')
+{
+}
+
+QStringList InstantCandidateFinder::nativeRoots(const QStringList &scanRoots) {
+    QStringList roots;
+    roots.reserve(scanRoots.size());
+    for (const QString &root : scanRoots) roots.append(QDir::toNativeSeparators(QDir::cleanPath(root)));
+    return roots;
+}
+
+bool InstantCandidateFinder::isUnderAnyRoot(const QString &nativePath, const QStringList &nativeRoots) {
+#if defined(Q_OS_WIN)
+    const Qt::CaseSensitivity cs = Qt::CaseInsensitive;
+#else
+    const Qt::CaseSensitivity cs = Qt::CaseSensitive;
+#endif
+    const QChar sep = QDir::separator();
+    for (const QString &root : nativeRoots) {
+        if (!nativePath.startsWith(root, cs)) continue;
+        if (nativePath.size() == root.size() || root.endsWith(sep) || nativePath.at(root.size()) == sep) return true;
+    }
+    return false;
+}
+
+QString InstantCandidateFinder::projectRootFor(const QString &path) const {
+    const QString cleanPath = QDir::fromNativeSeparators(path);
+    const qsizetype markerIndex = cleanPath.indexOf(m_nestedMarker);
+    if (markerIndex <= 0) return QString(); // No marker, or a project at the filesystem root
+    return QDir::toNativeSeparators(cleanPath.left(markerIndex));
+}
+
+QStringList InstantCandidateFinder::fromLocateDatabase(const QStringList &scanRoots) const {
+    QStringList projectRoots;
+#if defined(Q_OS_LINUX)
+    QString program = QStandardPaths::findExecutable(QStringLiteral("plocate"));
+    if (program.isEmpty()) program = QStandardPaths::findExecutable(QStringLiteral("locate")); // mlocate
+    if (program.isEmpty()) {
+        qDebug() << "InstantCandidateFinder: No locate program installed; skipping locate database.";
+        return projectRoots;
+    }
+
+    // POSIX extended regex; the nested part names only need their dots escaped.
+    QString markerPattern = m_nestedMarker;
+    markerPattern.replace(QLatin1Char('.'), QStringLiteral("\\."));
+    const QString pattern = markerPattern + QStringLiteral("\\.[^/]+\\.softudio$");
+
+    QStringList arguments;
+    const QString database = qEnvironmentVariable("SOFTUDIO_LOCATE_DB");
+    if (!database.isEmpty()) arguments << QStringLiteral("--database") << database;
+    arguments << QStringLiteral("--regex") << QStringLiteral("--limit") << QString::number(MAX_LOCATE_RESULTS) << pattern;
+
+    QProcess process;
+    process.start(program, arguments);
+    if (!process.waitForStarted(LOCATE_TIMEOUT_MS)) {
+        qWarning() << "InstantCandidateFinder: Could not start" << program << ":" << process.errorString();
+        return projectRoots;
+    }
+    if (!process.waitForFinished(LOCATE_TIMEOUT_MS)) {
+        qWarning() << "InstantCandidateFinder:" << program << "did not answer within" << LOCATE_TIMEOUT_MS << "ms; using partial output.";
+        process.kill();
+        process.waitForFinished();
+    }
+    if (process.exitStatus() == QProcess::NormalExit && process.exitCode() > 1) { // 1 just means "no match"
+        qWarning() << "InstantCandidateFinder:" << program << "failed:" << QString::fromLocal8Bit(process.readAllStandardError()).trimmed();
+    }
+
+    const QStringList roots = nativeRoots(scanRoots);
+    QSet<QString> seen;
+    const QList<QByteArray> lines = process.readAllStandardOutput().split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.isEmpty()) continue;
+        const QString root = projectRootFor(QString::fromLocal8Bit(line));
+        if (root.isEmpty() || seen.contains(root) || !isUnderAnyRoot(root, roots)) continue;
+        seen.insert(root);
+        projectRoots.append(root);
+    }
+    qDebug() << "InstantCandidateFinder:" << program << "listed" << projectRoots.size() << "project root(s).";
+#else
+    Q_UNUSED(scanRoots);
+#endif
+    return projectRoots;
+}
+
+QStringList InstantCandidateFinder::fromRecentFiles(const QStringList &scanRoots) const {
+    QStringList projectRoots;
+    QString fileName = qEnvironmentVariable("SOFTUDIO_RECENT_FILES_XBEL");
+    if (fileName.isEmpty()) fileName = QStandardPaths::locate(QStandardPaths::GenericDataLocation, QStringLiteral("recently-used.xbel"));
+    if (fileName.isEmpty()) return projectRoots;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "InstantCandidateFinder: Cannot read" << fileName << ":" << file.errorString();
+        return projectRoots;
+    }
+
+    const QStringList roots = nativeRoots(scanRoots);
+    const QString nestedStart = m_nestedMarker.section('/', 1, 2); // "softudio/engine"
+    QSet<QString> seen;
+    QSet<QString> checkedDirs;
+    int entries = 0;
+
+    QXmlStreamReader xml(&file);
+    while (!xml.atEnd() && entries < MAX_RECENT_ENTRIES) {
+        if (xml.readNext() != QXmlStreamReader::StartElement || xml.name() != QLatin1String("bookmark")) continue;
+        ++entries;
+        const QUrl url(xml.attributes().value(QLatin1String("href")).toString());
+        if (!url.isLocalFile()) continue;
+        const QString localPath = url.toLocalFile();
+
+        // A file inside the nested tree names its project directly; otherwise
+        // look a few levels up for a directory that has the nested tree.
+        QString root = projectRootFor(localPath);
+        if (root.isEmpty()) {
+            QString dir = QFileInfo(localPath).isDir() ? localPath : QFileInfo(localPath).path();
+            for (int level = 0; level <= RECENT_ANCESTOR_LEVELS && !dir.isEmpty(); ++level) {
+                if (checkedDirs.contains(dir)) break;
+                checkedDirs.insert(dir);
+                if (QFileInfo(dir + '/' + nestedStart).isDir()) {
+                    root = QDir::toNativeSeparators(dir);
+                    break;
+                }
+                const QString parent = QFileInfo(dir).path();
+                if (parent == dir) break;
+                dir = parent;
+            }
+        }
+        if (root.isEmpty() || seen.contains(root) || !isUnderAnyRoot(root, roots)) continue;
+        seen.insert(root);
+        projectRoots.append(root);
+    }
+    if (xml.hasError()) {
+        qWarning() << "InstantCandidateFinder: Stopped reading" << fileName << "at line" << xml.lineNumber() << ":" << xml.errorString();
+    }
+    qDebug() << "InstantCandidateFinder: Recent files list gave" << projectRoots.size() << "project root(s).";
+    return projectRoots;
+}
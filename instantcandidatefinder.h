@@ -0,0 +1,33 @@
+#ifndef INSTANTCANDIDATEFINDER_H
+#define INSTANTCANDIDATEFINDER_H
+
+#include <QString>
+#include <QStringList>
+
+// Project roots that can be known before walking a single directory:
+// paths of .softudio files already indexed by a locate database (plocate or
+// mlocate) and entries of the freedesktop recently-used.xbel list. Both are
+// cheap to read and may be stale, so every root returned still goes through
+// normal validation. Fixture files can stand in for the system ones through
+// SOFTUDIO_LOCATE_DB and SOFTUDIO_RECENT_FILES_XBEL.
+class InstantCandidateFinder {
+public:
+    explicit InstantCandidateFinder(const QStringList &nestedPathParts);
+
+    // Both return native project root paths lying under one of scanRoots.
+    QStringList fromLocateDatabase(const QStringList &scanRoots) const;
+    QStringList fromRecentFiles(const QStringList &scanRoots) const;
+
+    static const int LOCATE_TIMEOUT_MS = 3000;
+    static const int MAX_LOCATE_RESULTS = 10000;
+    static const int MAX_RECENT_ENTRIES = 2000;
+
+private:
+    QString projectRootFor(const QString &path) const; // Empty unless path lies inside a project's nested tree
+    static bool isUnderAnyRoot(const QString &nativePath, const QStringList &nativeRoots);
+    static QStringList nativeRoots(const QStringList &scanRoots);
+
+    QString m_nestedMarker;                 // "/softudio/.../project-data/"
+};
+
+#endif // INSTANTCANDIDATEFINDER_H
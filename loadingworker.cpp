@@ -1,66 +1,170 @@
 #include "loadingworker.h"
 #include "splash_constants.h" // For PROJECT_MANAGER_MODULE_NAME, ICON_PATH_REL, etc.
+#include "decodedimagecache.h"
+#include "startuptrace.h"
+#include "startupprefetcher.h"
+#include "projectjournal.h"
 
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
+#include <QDateTime>
 #include <QDebug>       // For qDebug() messages
-#include <QThread>      // For QThread::msleep, analogous to time.sleep
+#include <QThread>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QSet>
+#include <QSettings>
+#include <QImageReader>
+#include <QBuffer>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <exception>
 
-QVariantMap load_projects_cpp_equivalent(QString& errorMsg) {
+namespace {
+const QString TASK_COSTS_GROUP = QStringLiteral("LoadingTaskCosts");
+
+struct ImageJob {
+    QString name;       // Key in the images map
+    QString path;
+};
+
+// Decodes at the file's own size: nothing in this tree says how large the
+// project manager draws these, so no scale is guessed at. Warm starts find
+// the result in the decoded image cache and skip all of it.
+QImage decodeImage(const ImageJob &job)
+{
+    StartupTrace::Zone zone("Decode image", job.path, "loader");
+    const QSize nativeSize; // Cache key for images kept at their own size
+    QImage image = DecodedImageCache::shared().find(job.path, nativeSize);
+    if (!image.isNull()) return image;
+
+    // Read from the prefetched bytes when main() got to the file first.
+    QByteArray encoded;
+    QBuffer buffer(&encoded);
+    QImageReader reader;
+    if (StartupPrefetcher::take(job.path, encoded) && buffer.open(QIODevice::ReadOnly)) reader.setDevice(&buffer);
+    else reader.setFileName(job.path);
+    reader.setAutoTransform(true);
+    image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "[LoadingWorker] Warning: Failed to decode image:" << job.path << "-" << reader.errorString();
+        return image;
+    }
+    // The formats QPixmap::fromImage can take without another conversion.
+    image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32);
+    DecodedImageCache::shared().insert(job.path, nativeSize, image);
+    return image;
+}
+
+// Decodes all jobs in parallel on the global pool; the loading pool may be
+// busy with the task that is waiting here.
+QVariantMap decodeImages(const QList<ImageJob> &jobs)
+{
+    const QList<QImage> images = QtConcurrent::blockingMapped<QList<QImage>>(QThreadPool::globalInstance(), jobs, decodeImage);
+    QVariantMap result;
+    for (int i = 0; i < jobs.size(); ++i) {
+        if (!images.at(i).isNull()) result.insert(jobs.at(i).name, QVariant::fromValue(images.at(i)));
+    }
+    return result;
+}
+}
+
+// Snapshot first: when projects.snapshot matches projects.json it is mapped
+// and nothing is parsed. Otherwise the first-paint sections are parsed here
+// and the full store, projects array included, is built and saved on the
+// global pool; the returned store hands it out through allProjects().
+// Changes in projects.journal are replayed on top either way: the snapshot
+// only needs the records appended since it was saved, and is saved again
+// with them, so the next start maps it as is.
+ProjectStorePtr load_projects_cpp_equivalent(QString& errorMsg) {
 
     qDebug() << "[LoadingWorker - Placeholder] _task_load_project_data: Simulating project load.";
-    QString projectsFilePath = QDir::cleanPath(QCoreApplication::applicationDirPath() + "/projects.json");
+    QString projectsFilePath = QDir::cleanPath(QCoreApplication::applicationDirPath() + "/" + PROJECTS_FILE_NAME);
+    const QString snapshotPath = ProjectStore::snapshotPathFor(projectsFilePath);
+    ProjectJournal &journal = ProjectJournal::shared();
+    ProjectStorePtr snapshot = ProjectStore::open(snapshotPath, projectsFilePath);
+    const qint64 journalBytes = journal.size();
+    if (snapshot && journalBytes == snapshot->stamp().journalBytes) return snapshot;
+    if (snapshot && journalBytes > snapshot->stamp().journalBytes) {
+        ProjectLists lists = snapshot->lists(ProjectListParser::FirstPaintSections);
+        const int replayed = journal.replay(lists, snapshot->stamp().journalBytes);
+        if (replayed >= 0) {
+            qDebug() << "[LoadingWorker] Replayed" << replayed << "journaled project change(s) over the snapshot.";
+            const QFuture<ProjectStorePtr> allProjects = QtConcurrent::run(QThreadPool::globalInstance(),
+                [snapshot, snapshotPath, &journal]() {
+                    StartupTrace::Zone zone("Update project snapshot", "loader");
+                    ProjectLists all = snapshot->lists();
+                    ProjectStore::Stamp stamp = snapshot->stamp();
+                    journal.replay(all, stamp.journalBytes, &stamp.journalBytes);
+                    journal.compactIfNeeded(); // Only after the replay, which must not see a trimmed journal
+                    const ProjectStorePtr store = ProjectStore::build(all, stamp);
+                    store->save(snapshotPath);
+                    return store;
+                });
+            return ProjectStore::build(lists, snapshot->stamp(), allProjects);
+        }
+    }
+    // No snapshot, or the journal it includes is gone: start over from the JSON.
+
     QFile projectsFile(projectsFilePath);
+    const QFileInfo sourceInfo(projectsFile); // Stamped into the snapshot; taken before the read
+    ProjectStore::Stamp stamp;
+    stamp.sourceSize = sourceInfo.size();
+    stamp.sourceModifiedMs = sourceInfo.lastModified().toMSecsSinceEpoch();
+    QByteArray jsonData;
+    const bool prefetched = StartupPrefetcher::take(projectsFilePath, jsonData); // Usually already in memory
 
-    if (!projectsFile.exists()) {
+    if (!prefetched && !projectsFile.exists()) {
         errorMsg = QString("'%1' not found.").arg(QFileInfo(projectsFile).fileName());
         qDebug() << "[LoadingWorker] INFO:" << errorMsg << "- Starting with empty project lists.";
-        QVariantMap data;
-        data["projects"] = QVariantList();
-        data["recent"] = QVariantList();
-        data["visited"] = QVariantMap(); // Assuming visited is like {"path": timestamp}
-        data["pinned"] = QVariantList();
-        return data; // Return empty but valid structure
+        return ProjectStore::build(ProjectLists()); // Return empty but valid structure
     }
 
-    if (!projectsFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!prefetched && !projectsFile.open(QIODevice::ReadOnly)) {
         errorMsg = QString("Could not open '%1' for reading.").arg(QFileInfo(projectsFile).fileName());
         qDebug() << "[LoadingWorker] ERROR:" << errorMsg;
         // Return empty on error to mimic Python's behavior of proceeding with empty lists
-        QVariantMap data;
-        data["projects"] = QVariantList();
-        data["recent"] = QVariantList();
-        data["visited"] = QVariantMap();
-        data["pinned"] = QVariantList();
-        return data;
+        return ProjectStore::build(ProjectLists());
     }
 
-    QByteArray jsonData = projectsFile.readAll();
-    projectsFile.close();
-    QJsonDocument doc = QJsonDocument::fromJson(jsonData);
+    if (!prefetched) {
+        jsonData = projectsFile.readAll();
+        projectsFile.close();
+    }
 
-    if (doc.isNull() || !doc.isObject()) {
-        errorMsg = QString("Failed to parse '%1' or it's not a JSON object.").arg(QFileInfo(projectsFile).fileName());
-        qDebug() << "[LoadingWorker] ERROR:" << errorMsg;
-        QVariantMap data; // Return empty
-        data["projects"] = QVariantList(); data["recent"] = QVariantList(); data["visited"] = QVariantMap(); data["pinned"] = QVariantList();
-        return data;
-    }
-    // Assuming projects.json has keys: "projects", "recent_projects", "most_visited_folders", "pinned_folders"
-    // And their values are suitable for direct QVariant conversion (e.g. lists of strings/objects, map of string to string/number)
-    QJsonObject rootObj = doc.object();
-    QVariantMap loadedData;
-    loadedData["projects"] = rootObj.value("projects").toVariant(); // Example
-    loadedData["recent"]   = rootObj.value("recent_projects").toVariant();
-    loadedData["visited"]  = rootObj.value("most_visited_folders").toVariant();
-    loadedData["pinned"]   = rootObj.value("pinned_folders").toVariant();
-
-    return loadedData;
+    ProjectLists lists;
+    {
+        StartupTrace::Zone zone("Parse first-paint lists", "loader");
+        ProjectListParser parser(jsonData);
+        if (!parser.parse(ProjectListParser::FirstPaintSections, lists)) {
+            errorMsg = QString("Failed to parse '%1': %2").arg(QFileInfo(projectsFile).fileName(), parser.errorString());
+            qDebug() << "[LoadingWorker] ERROR:" << errorMsg;
+            return ProjectStore::build(ProjectLists());
+        }
+        journal.replay(lists);
+    }
+
+    // The lambda owns its copy of the bytes; the sections above are skipped this time.
+    const QFuture<ProjectStorePtr> allProjects = QtConcurrent::run(QThreadPool::globalInstance(),
+        [jsonData, lists, stamp, snapshotPath, &journal]() {
+            StartupTrace::Zone zone("Parse projects", "loader");
+            ProjectLists all = lists;
+            ProjectListParser parser(jsonData);
+            if (!parser.parse(ProjectListParser::ProjectsSection, all)) {
+                qDebug() << "[LoadingWorker] ERROR: Failed to parse projects:" << parser.errorString();
+                all.projects.clear();
+                return ProjectStore::build(all); // Unstamped; not worth a snapshot
+            }
+            ProjectStore::Stamp replayedStamp = stamp;
+            journal.replay(all, 0, &replayedStamp.journalBytes); // For the projects section; the rest replays to the same result
+            journal.compactIfNeeded();
+            const ProjectStorePtr store = ProjectStore::build(all, replayedStamp);
+            store->save(snapshotPath);
+            return store;
+        });
+    return ProjectStore::build(lists, stamp, allProjects);
 }
 // --- End Placeholder ---
 
@@ -76,75 +180,199 @@ LoadingWorker::LoadingWorker(const QList<TaskDefinition> &tasks, QObject *parent
 
 LoadingWorker::~LoadingWorker()
 {
+    m_pool.waitForDone(); // Pool tasks use this object
     qDebug() << "[LoadingWorker] Destroyed.";
 }
 
+QString LoadingWorker::taskKey(LoadingTask task)
+{
+    // Stable names for logs and the cost history; don't rename without a migration.
+    switch (task) {
+    case LoadingTask::ImportProjectManager: return QStringLiteral("import_projectmanager");
+    case LoadingTask::LoadProjectData: return QStringLiteral("load_project_data");
+    case LoadingTask::LoadIcons: return QStringLiteral("load_icons");
+    case LoadingTask::LoadTemplateImages: return QStringLiteral("load_template_images");
+    case LoadingTask::None: break;
+    }
+    return QString();
+}
+
+void LoadingWorker::loadTaskCosts()
+{
+    QSettings settings; // Organization and application names are set in main()
+    settings.beginGroup(TASK_COSTS_GROUP);
+    const QStringList keys = settings.childKeys();
+    for (const QString &key : keys) {
+        const double cost = settings.value(key).toDouble();
+        if (cost > 0.0) m_taskCosts.insert(key, cost);
+    }
+    settings.endGroup();
+}
+
+void LoadingWorker::saveTaskCosts() const
+{
+    QSettings settings;
+    settings.beginGroup(TASK_COSTS_GROUP);
+    for (auto it = m_taskCosts.cbegin(); it != m_taskCosts.cend(); ++it) settings.setValue(it.key(), it.value());
+    settings.endGroup();
+}
+
+bool LoadingWorker::runTask(LoadingTask task, QString &errorMessage)
+{
+    switch (task) {
+    case LoadingTask::ImportProjectManager: return task_import_projectmanager(errorMessage);
+    case LoadingTask::LoadProjectData: return task_load_project_data(errorMessage);
+    case LoadingTask::LoadIcons: return task_load_icons(errorMessage);
+    case LoadingTask::LoadTemplateImages: return task_load_template_images(errorMessage);
+    case LoadingTask::None: break;
+    }
+    errorMessage = QString("Unknown task: %1").arg(static_cast<int>(task));
+    return false;
+}
+
+void LoadingWorker::startTask(int index)
+{
+    const TaskDefinition definition = m_tasks.at(index);
+    emit task_started(definition.userMessage, definition.detailMessage);
+    m_pool.start([this, index, definition]() {
+        StartupTrace::Zone zone("Loading task", taskKey(definition.task), "loader");
+        TaskRun result;
+        result.index = index;
+        QElapsedTimer timer;
+        timer.start();
+        try {
+            result.success = runTask(definition.task, result.errorMessage);
+        } catch (const std::exception &e) {
+            result.errorMessage = QString("Unexpected C++ exception during task '%1': %2")
+                                      .arg(taskKey(definition.task), QString::fromStdString(e.what()));
+            qCritical() << "[LoadingWorker] CRITICAL ERROR:" << result.errorMessage;
+        } catch (...) {
+            result.errorMessage = QString("Unknown C++ exception during task '%1'.").arg(taskKey(definition.task));
+            qCritical() << "[LoadingWorker] CRITICAL ERROR:" << result.errorMessage;
+        }
+        result.elapsedMs = timer.elapsed();
+
+        QMutexLocker locker(&m_finishedMutex);
+        m_finishedQueue.append(result);
+        m_taskFinished.wakeOne();
+    });
+}
+
 void LoadingWorker::run()
 {
     qDebug() << "[LoadingWorker] Run started on thread:" << QThread::currentThreadId();
-    int totalSteps = 0;
-    for (const auto &task : m_tasks) {
-        if (!task.methodName.isEmpty()) {
-            totalSteps++;
-        }
+    StartupTrace::Zone runZone("Loading", "loader");
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+    loadTaskCosts();
+
+    // Progress is weighted by how long each task took on earlier starts, so
+    // the bar moves at a steady pace instead of jumping per step.
+    QList<double> weights;
+    double totalWeight = 0.0;
+    for (const auto &definition : m_tasks) {
+        const double weight = definition.task == LoadingTask::None ? 0.0 : m_taskCosts.value(taskKey(definition.task), DEFAULT_TASK_COST_MS);
+        weights.append(weight);
+        totalWeight += weight;
     }
 
-    int currentStep = 0;
-    for (const auto &task : m_tasks) {
+    QList<bool> started(m_tasks.size(), false);
+    QSet<int> completed; // LoadingTask values
+    auto dependenciesMet = [this, &completed](int index) {
+        for (LoadingTask dependency : m_tasks.at(index).dependsOn) {
+            if (!completed.contains(static_cast<int>(dependency))) return false;
+        }
+        return true;
+    };
+
+    int running = 0;
+    double doneWeight = 0.0;
+    qint64 summedTaskMs = 0;
+    QString failedContext;
+    emit progress_updated(0);
+
+    while (true) {
+        if (failedContext.isEmpty()) {
+            for (int i = 0; i < m_tasks.size(); ++i) {
+                if (started.at(i) || m_tasks.at(i).task == LoadingTask::None || !dependenciesMet(i)) continue;
+                started[i] = true;
+                ++running;
+                startTask(i);
+            }
+        }
+        if (running == 0) break;
+
+        QList<TaskRun> finished;
+        {
+            QMutexLocker locker(&m_finishedMutex);
+            if (m_finishedQueue.isEmpty()) m_taskFinished.wait(&m_finishedMutex, CANCEL_POLL_MS);
+            finished.swap(m_finishedQueue);
+        }
+
         if (QThread::currentThread()->isInterruptionRequested()) {
+            m_pool.clear();       // Drop tasks that have not started
+            m_pool.waitForDone(); // And let running ones finish; they use this object
             m_errorMessage = "Loading was cancelled by user.";
             emit loading_error("Cancellation", m_errorMessage);
             return;
         }
 
-        if (!task.methodName.isEmpty()) {
-            emit task_started(task.userMessage, task.detailMessage);
-            bool success = false;
-            try {
-                if (task.methodName == "_task_import_projectmanager") {
-                    success = task_import_projectmanager();
-                } else if (task.methodName == "_task_load_project_data") {
-                    success = task_load_project_data();
-                } else if (task.methodName == "_task_load_icons") {
-                    success = task_load_icons();
-                } else if (task.methodName == "_task_load_template_images") {
-                    success = task_load_template_images();
-                } else {
-                    m_errorMessage = QString("Unknown task method: %1").arg(task.methodName);
-                    success = false;
-                }
-
-                if (!success) {
-                    // m_errorMessage should have been set by the task method
-                    emit loading_error(task.errorContext, m_errorMessage);
-                    return;
+        for (const TaskRun &result : finished) {
+            --running;
+            const TaskDefinition &definition = m_tasks.at(result.index);
+            if (!result.success) {
+                // The first failure is reported; tasks already running are allowed to finish.
+                if (failedContext.isEmpty()) {
+                    failedContext = definition.errorContext;
+                    m_errorMessage = result.errorMessage;
                 }
-            } catch (const std::exception &e) {
-                m_errorMessage = QString("Unexpected C++ exception during task '%1': %2")
-                                     .arg(task.methodName, QString::fromStdString(e.what()));
-                qCritical() << "[LoadingWorker] CRITICAL ERROR:" << m_errorMessage;
-                emit loading_error(task.errorContext, m_errorMessage);
-                return;
-            } catch (...) {
-                m_errorMessage = QString("Unknown C++ exception during task '%1'.").arg(task.methodName);
-                qCritical() << "[LoadingWorker] CRITICAL ERROR:" << m_errorMessage;
-                emit loading_error(task.errorContext, m_errorMessage);
-                return;
+                continue;
             }
-            currentStep++;
-            emit progress_updated(currentStep);
-        } else if (task.userMessage == "Finalizing...") { // Handle special tasks from Python list
-            emit task_started(task.userMessage, task.detailMessage);
-            QThread::msleep(200); // Analogous to time.sleep(0.2)
+            completed.insert(static_cast<int>(definition.task));
+            summedTaskMs += result.elapsedMs;
+            const QString key = taskKey(definition.task);
+            const auto previous = m_taskCosts.constFind(key);
+            m_taskCosts.insert(key, previous == m_taskCosts.constEnd()
+                                        ? double(result.elapsedMs)
+                                        : previous.value() * (1.0 - COST_SMOOTHING) + result.elapsedMs * COST_SMOOTHING);
+            doneWeight += weights.at(result.index);
+            emit progress_updated(totalWeight > 0.0 ? qRound(doneWeight / totalWeight * PROGRESS_MAXIMUM) : PROGRESS_MAXIMUM);
         }
     }
-    emit loading_complete(m_projectManagerClassPlaceholder, m_loadedProjectData, m_loadedImages);
+
+    if (!failedContext.isEmpty()) {
+        emit loading_error(failedContext, m_errorMessage);
+        return;
+    }
+    for (int i = 0; i < m_tasks.size(); ++i) {
+        if (m_tasks.at(i).task != LoadingTask::None && !started.at(i)) {
+            m_errorMessage = QString("Task '%1' depends on a task that is missing or never finishes.").arg(taskKey(m_tasks.at(i).task));
+            emit loading_error(m_tasks.at(i).errorContext, m_errorMessage);
+            return;
+        }
+    }
+    saveTaskCosts();
+    StartupPrefetcher::discard(); // Buffers of images the decoded cache already had
+    {
+        StartupTrace::Zone zone("Save decoded image cache", "loader");
+        DecodedImageCache::shared().write(); // Only when something had to be decoded
+    }
+    qDebug() << "[LoadingWorker] Tasks finished in" << wallTimer.elapsed() << "ms (" << summedTaskMs << "ms if run one after another).";
+
+    for (const auto &definition : m_tasks) {
+        if (definition.task == LoadingTask::None && definition.userMessage == "Finalizing...") { // Handle special tasks from Python list
+            emit task_started(definition.userMessage, definition.detailMessage);
+        }
+    }
+    emit progress_updated(PROGRESS_MAXIMUM);
+    emit loading_complete(m_projectManagerClassPlaceholder, m_projectStore, m_loadedImages);
     qDebug() << "[LoadingWorker] Run finished.";
 }
 
-bool LoadingWorker::task_import_projectmanager()
+bool LoadingWorker::task_import_projectmanager(QString &errorMessage)
 {
     qDebug() << "[LoadingWorker] Executing task: Import ProjectManager";
+    QMutexLocker locker(&m_resultMutex);
     // Placeholder: Let's say the C++ class will be named "ProjectManagerWidgetCpp"
     m_projectManagerClassPlaceholder = "ProjectManagerWidgetCpp"; // This string is a placeholder.
                                                                  // The main thread will use this info
@@ -152,7 +380,7 @@ bool LoadingWorker::task_import_projectmanager()
 
     // Simulate check or light initialization
     if (PROJECT_MANAGER_MODULE_NAME.isEmpty()) { // Using constant for consistency
-        m_errorMessage = "Project manager module name (constant) is not defined.";
+        errorMessage = "Project manager module name (constant) is not defined.";
         return false;
     }
 
@@ -160,71 +388,58 @@ bool LoadingWorker::task_import_projectmanager()
     return true;
 }
 
-bool LoadingWorker::task_load_project_data()
+bool LoadingWorker::task_load_project_data(QString &errorMessage)
 {
     qDebug() << "[LoadingWorker] Executing task: Load Project Data";
-    if (m_projectManagerClassPlaceholder.isEmpty()) { // Check if previous step "succeeded"
-        m_errorMessage = "Project manager module not 'loaded' (placeholder not set), cannot load project data.";
-        return false;
+    {
+        QMutexLocker locker(&m_resultMutex);
+        if (m_projectManagerClassPlaceholder.isEmpty()) { // Check if previous step "succeeded"
+            errorMessage = "Project manager module not 'loaded' (placeholder not set), cannot load project data.";
+            return false;
+        }
     }
     // This would call the C++ equivalent of projectmanager.load_projects()
-    m_loadedProjectData = load_projects_cpp_equivalent(m_errorMessage); // Pass m_errorMessage by reference
+    const ProjectStorePtr projectStore = load_projects_cpp_equivalent(errorMessage); // Pass errorMessage by reference
 
-    if (!m_errorMessage.isEmpty() && m_loadedProjectData.isEmpty()){ // Check if a real error prevented even default data
+    if (!errorMessage.isEmpty() && !projectStore){ // Check if a real error prevented even default data
         return false; 
     }
-    m_errorMessage.clear(); // Clear if successfully loaded or defaulted.
-    qDebug() << "[LoadingWorker] Project data loaded/defaulted. Count:" << m_loadedProjectData.value("projects").toList().count();
+    errorMessage.clear(); // Clear if successfully loaded or defaulted.
+    qDebug() << "[LoadingWorker] Project data loaded/defaulted. Rows:" << projectStore->count()
+             << (projectStore->isMapped() ? "(snapshot)" : projectStore->hasAllProjects() ? "" : "(projects still loading)");
+    QMutexLocker locker(&m_resultMutex);
+    m_projectStore = projectStore;
     return true;
 }
 
-bool LoadingWorker::task_load_icons()
+bool LoadingWorker::task_load_icons(QString &errorMessage)
 {
+    Q_UNUSED(errorMessage);
     qDebug() << "[LoadingWorker] Executing task: Load Icons";
-    QMap<QString, QString> iconsToLoad;
-    iconsToLoad["star_icon"] = QDir::cleanPath(m_workerBasePath + "/" + ICON_PATH_REL + "/star.png");
-    iconsToLoad["star_outline_icon"] = QDir::cleanPath(m_workerBasePath + "/" + ICON_PATH_REL + "/star_outline.png");
-
-    for (auto it = iconsToLoad.constBegin(); it != iconsToLoad.constEnd(); ++it) {
-        const QString &name = it.key();
-        const QString &path = it.value();
-        if (QFile::exists(path)) {
-            QPixmap pixmap(path);
-            if (!pixmap.isNull()) {
-                m_loadedImages[name] = QVariant::fromValue(pixmap);
-            } else {
-                qWarning() << "[LoadingWorker] Warning: Failed to load icon (Pixmap isNull):" << path;
-            }
-        } else {
-            qWarning() << "[LoadingWorker] Warning: Icon not found:" << path;
-        }
-    }
+    const QString iconDir = QDir::cleanPath(m_workerBasePath + "/" + ICON_PATH_REL);
+    const QList<ImageJob> jobs = {
+        { "star_icon", iconDir + "/" + STAR_ICON_FILE },
+        { "star_outline_icon", iconDir + "/" + STAR_OUTLINE_ICON_FILE }
+    };
+    const QVariantMap icons = decodeImages(jobs);
+    QMutexLocker locker(&m_resultMutex);
+    m_loadedImages.insert(icons);
     // Python version always returns True for this task
     return true;
 }
 
-bool LoadingWorker::task_load_template_images()
+bool LoadingWorker::task_load_template_images(QString &errorMessage)
 {
+    Q_UNUSED(errorMessage);
     qDebug() << "[LoadingWorker] Executing task: Load Template Images";
-    QStringList templateImagesPaths;
-    templateImagesPaths << QDir::cleanPath(m_workerBasePath + "/" + TEMPLATE_IMAGE_PATH_REL + "/BlankTemplate.jpg");
-    templateImagesPaths << QDir::cleanPath(m_workerBasePath + "/" + TEMPLATE_IMAGE_PATH_REL + "/UIExample.jpg");
-    templateImagesPaths << QDir::cleanPath(m_workerBasePath + "/" + TEMPLATE_IMAGE_PATH_REL + "/WebappExample.jpg");
-    templateImagesPaths << QDir::cleanPath(m_workerBasePath + "/" + TEMPLATE_IMAGE_PATH_REL + "/BuildExample.jpg");
-
-    for (int i = 0; i < templateImagesPaths.size(); ++i) {
-        const QString &path = templateImagesPaths.at(i);
-        if (QFile::exists(path)) {
-            QPixmap pixmap(path);
-            if (!pixmap.isNull()) {
-                m_loadedImages[QString("template_%1").arg(i)] = QVariant::fromValue(pixmap);
-            } else {
-                qWarning() << "[LoadingWorker] Warning: Failed to load template image (Pixmap isNull):" << path;
-            }
-        } else {
-            qWarning() << "[LoadingWorker] Warning: Template image not found:" << path;
-        }
+    const QString templateDir = QDir::cleanPath(m_workerBasePath + "/" + TEMPLATE_IMAGE_PATH_REL);
+    QList<ImageJob> jobs;
+    for (int i = 0; i < TEMPLATE_IMAGE_FILES.size(); ++i) {
+        jobs.append({ QString("template_%1").arg(i), templateDir + "/" + TEMPLATE_IMAGE_FILES.at(i) });
     }
+    const QVariantMap templates = decodeImages(jobs);
+    QMutexLocker locker(&m_resultMutex);
+    m_loadedImages.insert(templates);
     // Python version always returns True for this task
     return true;
 }
\ No newline at end of file
@@ -3,19 +3,35 @@
 
 #include <QObject>
 #include <QString>
-#include <QVariantMap> // For loaded_project_data and loaded_images
+#include <QVariantMap> // For loaded_images
 #include <QList>       // For tasks
-#include <QPixmap>     // For loaded_images value type, though QVariantMap handles QVariant
+#include <QImage>      // For loaded_images value type, though QVariantMap handles QVariant
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include "projectstore.h"
 
 // Forward declaration if ProjectManagerWidget becomes a known C++ type
 // class ProjectManagerWidget;
 
-// Define a structure for tasks, similar to the Python tuples
+// The loading steps LoadingWorker knows how to run.
+enum class LoadingTask {
+    None,               // Status message only, nothing to run
+    ImportProjectManager,
+    LoadProjectData,
+    LoadIcons,
+    LoadTemplateImages
+};
+
+// One node of the loading graph. A task starts on the pool as soon as every
+// task in dependsOn has finished; independent tasks run side by side.
 struct TaskDefinition {
     QString userMessage;
     QString detailMessage;
-    QString methodName; // Name of the method to call in LoadingWorker
+    LoadingTask task;
     QString errorContext;
+    QList<LoadingTask> dependsOn;
 };
 
 class LoadingWorker : public QObject
@@ -26,12 +42,14 @@ public:
     explicit LoadingWorker(const QList<TaskDefinition> &tasks, QObject *parent = nullptr);
     ~LoadingWorker() override;
 
+    static const int PROGRESS_MAXIMUM = 1000; // progress_updated runs from 0 to this
+
 signals:
     void task_started(const QString &user_msg, const QString &detail_msg);
     void progress_updated(int progress_value);
 
     void loading_complete(const QString &main_window_class_placeholder,
-                          const QVariantMap &project_data,
+                          const ProjectStorePtr &project_store,
                           const QVariantMap &images);
     void loading_error(const QString &error_context, const QString &error_message);
 
@@ -39,18 +57,43 @@ public slots:
     void run(); // This will be called when the thread starts
 
 private:
-    // Task methods corresponding to Python _task_... methods
-    bool task_import_projectmanager();
-    bool task_load_project_data();
-    bool task_load_icons();
-    bool task_load_template_images();
+    struct TaskRun {
+        int index = -1;                 // Into m_tasks
+        bool success = false;
+        qint64 elapsedMs = 0;
+        QString errorMessage;
+    };
+
+    // Task methods corresponding to Python _task_... methods. They run on pool
+    // threads, so each reports its own error and publishes results under m_resultMutex.
+    bool task_import_projectmanager(QString &errorMessage);
+    bool task_load_project_data(QString &errorMessage);
+    bool task_load_icons(QString &errorMessage);
+    bool task_load_template_images(QString &errorMessage);
+
+    bool runTask(LoadingTask task, QString &errorMessage);
+    void startTask(int index);
+    void loadTaskCosts();
+    void saveTaskCosts() const;
+    static QString taskKey(LoadingTask task);
 
     QList<TaskDefinition> m_tasks;
     QString m_projectManagerClassPlaceholder; // To store the "type" of ProjectManagerWidget
-    QVariantMap m_loadedProjectData;
-    QVariantMap m_loadedImages; // Stores QPixmap by name (QVariant can hold QPixmap)
+    ProjectStorePtr m_projectStore;
+    QVariantMap m_loadedImages; // Stores decoded QImage by name; the GUI thread turns them into pixmaps
     QString m_errorMessage;
     QString m_workerBasePath;
+
+    QThreadPool m_pool;
+    QMutex m_resultMutex;               // Guards the loaded results above
+    QMutex m_finishedMutex;             // Guards m_finishedQueue
+    QWaitCondition m_taskFinished;
+    QList<TaskRun> m_finishedQueue;     // Finished but not yet handled by run()
+    QHash<QString, double> m_taskCosts; // Task key -> smoothed duration in ms from earlier starts
+
+    static constexpr double DEFAULT_TASK_COST_MS = 100.0;
+    static constexpr double COST_SMOOTHING = 0.3; // Weight of the newest measurement
+    static const int CANCEL_POLL_MS = 50;
 };
 
 #endif // LOADINGWORKER_H
\ No newline at end of file
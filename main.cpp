@@ -5,10 +5,15 @@
 #include <QFile>
 #include <QMessageBox>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QTimer>
 
 // #include "splashscreen.h" // Bypassing splash
 #include "splash_constants.h"
 #include "scannerdialog.h" // <<< INCLUDE SCANNERDIALOG
+#include "startuptrace.h"
+// #include "startupprefetcher.h" // Only the bypassed splash's loader takes the prefetched files
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <shobjidl.h>
@@ -18,9 +23,42 @@ QString get_application_asset_path(const QString &relative_path) {
     return QDir::cleanPath(QCoreApplication::applicationDirPath() + QDir::separator() + relative_path);
 }
 
+// Set SOFTUDIO_STARTUP_BENCHMARK=1 to log the time from main() to the first dialog paint and exit.
+// With tracing on, the same first paint is marked in the trace.
+class StartupBenchmarkFilter : public QObject {
+public:
+    explicit StartupBenchmarkFilter(const QElapsedTimer &sinceMain, bool quitAfterPaint, QObject *parent = nullptr)
+        : QObject(parent), m_sinceMain(sinceMain), m_quitAfterPaint(quitAfterPaint) {}
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override {
+        if (event->type() == QEvent::Paint) {
+            StartupTrace::instant("First dialog paint");
+            watched->removeEventFilter(this);
+            if (m_quitAfterPaint) {
+                qInfo().noquote() << QString("Startup benchmark: first dialog paint %1 ms after main()")
+                                         .arg(m_sinceMain.nsecsElapsed() / 1e6, 0, 'f', 1);
+                QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+            }
+        }
+        return false;
+    }
+
+private:
+    QElapsedTimer m_sinceMain;
+    bool m_quitAfterPaint;
+};
+
 int main(int argc, char *argv[])
 {
+    QElapsedTimer sinceMain;
+    sinceMain.start();
+    StartupTrace::initialize(argc, argv);
+    // StartupPrefetcher::start(); // Disk reads overlap with QApplication's platform setup; re-enable with the splash
+
+    StartupTrace::Zone appZone("QApplication construction");
     QApplication app(argc, argv);
+    appZone.end();
 
 #if defined(_WIN32) || defined(_WIN64)
     if (FAILED(SetCurrentProcessExplicitAppUserModelID(APP_USER_MODEL_ID.toStdWString().c_str()))) {
@@ -33,13 +71,17 @@ int main(int argc, char *argv[])
     app.setApplicationName(APP_NAME);
     app.setOrganizationName(ORG_NAME);
 
-    if (QStyleFactory::keys().contains("Fusion", Qt::CaseInsensitive)) {
-        QApplication::setStyle(QStyleFactory::create("Fusion"));
-        qDebug() << "Fusion style applied.";
-    } else {
-        qDebug() << "Fusion style not found. Using default style.";
+    {
+        StartupTrace::Zone zone("Style setup");
+        if (QStyleFactory::keys().contains("Fusion", Qt::CaseInsensitive)) {
+            QApplication::setStyle(QStyleFactory::create("Fusion"));
+            qDebug() << "Fusion style applied.";
+        } else {
+            qDebug() << "Fusion style not found. Using default style.";
+        }
     }
 
+    StartupTrace::Zone iconZone("Application icon");
     QString globalIconPath = get_application_asset_path(APP_ICON_PATH_PRIMARY_REL);
     if (!QFile::exists(globalIconPath)) {
         globalIconPath = get_application_asset_path(APP_ICON_PATH_FALLBACK_REL);
@@ -50,13 +92,25 @@ int main(int argc, char *argv[])
     } else {
         qWarning() << "Global application icon not found.";
     }
+    iconZone.end();
 
     qDebug() << "Bypassing SplashScreen, launching ScannerDialog directly for testing.";
-    ScannerDialog scannerDialog(nullptr);
-    scannerDialog.setAttribute(Qt::WA_DeleteOnClose);
-    
+    StartupTrace::Zone dialogZone("ScannerDialog construction");
+    ScannerDialog scannerDialog(nullptr); // Stack object: no WA_DeleteOnClose, exec() would delete it
+    dialogZone.end();
+
+    const bool benchmark = qEnvironmentVariableIsSet("SOFTUDIO_STARTUP_BENCHMARK");
+    if (benchmark) {
+        qInfo().noquote() << QString("Startup benchmark: dialog constructed %1 ms after main()")
+                                 .arg(sinceMain.nsecsElapsed() / 1e6, 0, 'f', 1);
+    }
+    if (benchmark || StartupTrace::isEnabled()) {
+        scannerDialog.installEventFilter(new StartupBenchmarkFilter(sinceMain, benchmark, &scannerDialog));
+    }
+
     int result = scannerDialog.exec();
     qDebug() << "ScannerDialog closed with result:" << result;
+    StartupTrace::write();
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "pathtree.h"
+
+#include <QDir>
+#include <QReadLocker>
+#include <QWriteLocker>
+
+PathTree::PathTree() {
+    m_nodes.append({0, 0}); // PathId 0: no path
+}
+
+PathTree &PathTree::shared() {
+    static PathTree tree;
+    return tree;
+}
+
+QStringList PathTree::splitPath(const QString &path) {
+    auto isSeparator = [](QChar c) { return c == QLatin1Char('/') || c == QLatin1Char('\\'); };
+
+    QStringList components;
+    qsizetype i = 0;
+    while (i < path.size() && isSeparator(path.at(i))) ++i;
+    if (i > 0) components.append(QDir::toNativeSeparators(path.left(i))); // "/" or a UNC "\\" prefix
+
+    qsizetype start = i;
+    for (; i <= path.size(); ++i) {
+        if (i == path.size() || isSeparator(path.at(i))) {
+            if (i > start) components.append(path.mid(start, i - start));
+            start = i + 1;
+        }
+    }
+    return components;
+}
+
+PathId PathTree::findLocked(const QStringList &components) const {
+    PathId id = 0;
+    for (const QString &component : components) {
+        const auto componentIt = m_componentIds.constFind(component);
+        if (componentIt == m_componentIds.constEnd()) return 0;
+        const auto childIt = m_children.constFind(childKey(id, componentIt.value()));
+        if (childIt == m_children.constEnd()) return 0;
+        id = childIt.value();
+    }
+    return id;
+}
+
+PathId PathTree::find(const QString &path) const {
+    const QStringList components = splitPath(path);
+    QReadLocker locker(&m_lock);
+    return findLocked(components);
+}
+
+PathId PathTree::intern(const QString &path) {
+    const QStringList components = splitPath(path);
+    if (components.isEmpty()) return 0;
+    {
+        QReadLocker locker(&m_lock); // Most lookups hit existing nodes
+        const PathId existing = findLocked(components);
+        if (existing) return existing;
+    }
+
+    QWriteLocker locker(&m_lock);
+    PathId id = 0;
+    for (const QString &component : components) {
+        quint32 componentId;
+        const auto componentIt = m_componentIds.constFind(component);
+        if (componentIt != m_componentIds.constEnd()) {
+            componentId = componentIt.value();
+        } else {
+            componentId = static_cast<quint32>(m_components.size());
+            m_components.append(component);
+            m_componentIds.insert(component, componentId);
+        }
+
+        const quint64 key = childKey(id, componentId);
+        const auto childIt = m_children.constFind(key);
+        if (childIt != m_children.constEnd()) {
+            id = childIt.value();
+            continue;
+        }
+        const PathId child = static_cast<PathId>(m_nodes.size());
+        m_nodes.append({id, componentId});
+        m_children.insert(key, child);
+        id = child;
+    }
+    return id;
+}
+
+PathId PathTree::parent(PathId id) const {
+    QReadLocker locker(&m_lock);
+    return id > 0 && id < static_cast<PathId>(m_nodes.size()) ? m_nodes.at(id).parent : 0;
+}
+
+QString PathTree::name(PathId id) const {
+    QReadLocker locker(&m_lock);
+    if (id == 0 || id >= static_cast<PathId>(m_nodes.size())) return QString();
+    return m_components.at(m_nodes.at(id).component);
+}
+
+QString PathTree::path(PathId id) const {
+    QReadLocker locker(&m_lock);
+    if (id == 0 || id >= static_cast<PathId>(m_nodes.size())) return QString();
+
+    QVarLengthArray<quint32, 32> chain;
+    for (PathId node = id; node != 0; node = m_nodes.at(node).parent) chain.append(m_nodes.at(node).component);
+
+    const QChar separator = QDir::separator();
+    QString result;
+    for (qsizetype i = chain.size() - 1; i >= 0; --i) {
+        const QString &component = m_components.at(chain.at(i));
+        if (!result.isEmpty() && !result.endsWith(separator)) result += separator;
+        result += component;
+    }
+    if (chain.size() == 1 && result.endsWith(QLatin1Char(':'))) result += separator; // Drive root "C:\"
+    return result;
+}
+
+int PathTree::nodeCount() const {
+    QReadLocker locker(&m_lock);
+    return m_nodes.size() - 1;
+}
@@ -0,0 +1,49 @@
+#ifndef PATHTREE_H
+#define PATHTREE_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QVarLengthArray>
+
+typedef quint32 PathId; // 0 is "no path"
+
+// Process-wide interning of filesystem paths as a parent-pointer tree.
+// Every component name is stored once and every path is a compact node id, so
+// records can keep a PathId instead of a full absolute QString and compare
+// paths as integers. Strings are only rebuilt by path() when displayed or
+// exported. Thread-safe: the scan worker interns while the GUI renders.
+class PathTree {
+public:
+    static PathTree &shared();
+
+    PathId intern(const QString &path);         // Adds missing nodes
+    PathId find(const QString &path) const;     // Lookup only; 0 when unknown
+
+    PathId parent(PathId id) const;
+    QString name(PathId id) const;              // Last component
+    QString path(PathId id) const;              // Native separators
+    int nodeCount() const;
+
+private:
+    PathTree();
+
+    struct Node {
+        PathId parent;
+        quint32 component;
+    };
+
+    static QStringList splitPath(const QString &path);
+    static quint64 childKey(PathId parent, quint32 component) { return (quint64(parent) << 32) | component; }
+    PathId findLocked(const QStringList &components) const;
+
+    mutable QReadWriteLock m_lock;
+    QList<Node> m_nodes;                        // Indexed by PathId; entry 0 is a sentinel
+    QStringList m_components;
+    QHash<QString, quint32> m_componentIds;
+    QHash<quint64, PathId> m_children;
+};
+
+#endif // PATHTREE_H
@@ -6,9 +6,11 @@
 #include <QDebug>
 #include <QtConcurrent/QtConcurrentRun> // For QtConcurrent::run
 #include <QThreadPool> // Good to include when using QtConcurrent
+#include "scanthrottle.h"
+#include "startuptrace.h"
 
 ProjectFileValidatorWorker::ProjectFileValidatorWorker(QObject *parent)
-    : QObject(parent), m_isBusy(false)
+    : QObject(parent), m_isBusy(false), m_backgroundMode(false)
 {
     // qRegisterMetaType for ValidationResult is done in .h with Q_DECLARE_METATYPE
     connect(&m_validationWatcher, &QFutureWatcher<ValidationResult>::finished,
@@ -30,21 +32,38 @@ ProjectFileValidatorWorker::~ProjectFileValidatorWorker()
     }
 }
 
+void ProjectFileValidatorWorker::setBackgroundMode(bool enabled) {
+    m_backgroundMode = enabled;
+}
+
 void ProjectFileValidatorWorker::validateProject(const ProjectInfo &projectToValidate) {
     if (m_isBusy) {
-        qWarning() << "ProjectFileValidatorWorker is busy. Skipping validation for:" << projectToValidate.path;
-        emit projectValidated(projectToValidate, false, "", "", true, "Validator was busy, request skipped.");
+        // Bursts (e.g. instant candidates) used to be rejected here; queue them instead.
+        m_pendingValidations.enqueue(projectToValidate);
         return;
     }
+    startValidation(projectToValidate);
+}
 
+void ProjectFileValidatorWorker::startNextPendingValidation() {
+    if (!m_isBusy && !m_pendingValidations.isEmpty()) startValidation(m_pendingValidations.dequeue());
+}
+
+void ProjectFileValidatorWorker::startValidation(const ProjectInfo &projectToValidate) {
     m_isBusy = true;
     m_currentProjectInfo = projectToValidate; // Store for timeout case
 
     // --- THIS IS THE CORRECTED QtConcurrent::run CALL using a LAMBDA ---
-    QFuture<ValidationResult> future = QtConcurrent::run([this, projectToValidate]() {
+    const bool background = m_backgroundMode;
+    QFuture<ValidationResult> future = QtConcurrent::run([this, projectToValidate, background]() {
         // 'projectToValidate' is captured by value for use in the thread
         // 'this' is captured to call the member function
-        return this->performActualValidation(projectToValidate);
+        // Pool threads are shared, so only the I/O class is lowered, and put back afterwards.
+        StartupTrace::Zone zone("Validate project", projectToValidate.path, "scan");
+        const int previousIoPriority = background ? ScanThrottle::beginIdleIo() : -1;
+        ValidationResult result = this->performActualValidation(projectToValidate);
+        ScanThrottle::endIdleIo(previousIoPriority);
+        return result;
     });
     // --- END OF CORRECTION ---
 
@@ -67,22 +86,7 @@ ValidationResult ProjectFileValidatorWorker::performActualValidation(ProjectInfo
         return ValidationResult(projectToValidate, isValidOut, validatedNameOut, validatedUidOut, false, errorMessageOut);
     }
 
-    QString folderName = rootDir.dirName();
-    if (folderName.isEmpty() && (projectRootPath.endsWith('/') || projectRootPath.endsWith('\\'))){
-         QDir tempDir(projectRootPath);
-         if (tempDir.cdUp()) folderName = tempDir.dirName(); 
-    }
-     if (folderName.isEmpty() || folderName == "." || folderName == "..") { 
-        QFileInfo fi(projectRootPath);
-        folderName = fi.fileName(); 
-        if(folderName.isEmpty() || folderName == "." || folderName == "..") folderName = fi.absoluteDir().dirName();
-    }
-
-    QString validFolderNameForFile = folderName;
-    validFolderNameForFile.removeIf([](QChar c){ return !c.isLetterOrNumber() && c != '_'; });
-    if (validFolderNameForFile.isEmpty() && !folderName.isEmpty()){
-         qDebug() << "Validation Info (" << projectRootPath << "): Sanitized folder name became empty. Original:" << folderName;
-    }
+    const QString folderName = projectFolderName(projectRootPath);
 
     QDir nestedDir(projectRootPath); 
     for(const QString& part : SOFTUDIO_NESTED_PATH_PARTS){
@@ -100,8 +104,7 @@ ValidationResult ProjectFileValidatorWorker::performActualValidation(ProjectInfo
         return ValidationResult(projectToValidate, isValidOut, validatedNameOut, validatedUidOut, false, errorMessageOut);
     }
 
-    QString expectedFileName = "." + validFolderNameForFile + SOFTUDIO_FILE_EXTENSION;
-    QString expectedFilePath = nestedDir.filePath(expectedFileName);
+    QString expectedFilePath = projectFilePath(projectRootPath);
 
     QFileInfo projectFileInfo(expectedFilePath);
     if (!projectFileInfo.exists() || !projectFileInfo.isFile()) {
@@ -115,11 +118,52 @@ ValidationResult ProjectFileValidatorWorker::performActualValidation(ProjectInfo
         return ValidationResult(projectToValidate, isValidOut, validatedNameOut, validatedUidOut, false, errorMessageOut);
     }
 
-    QFile projectFile(expectedFilePath);
+    QString foundProjectNameInFile;
+    if (readProjectFile(expectedFilePath, validatedUidOut, foundProjectNameInFile, errorMessageOut)) {
+        isValidOut = true;
+        validatedNameOut = foundProjectNameInFile.isEmpty() ? folderName : foundProjectNameInFile;
+        qDebug() << "Validation SUCCESS (" << projectRootPath << "): Name:" << validatedNameOut << "UID:" << validatedUidOut;
+    } else {
+        qDebug() << "Validation FAILURE (" << projectRootPath << "):" << errorMessageOut;
+    }
+
+    return ValidationResult(projectToValidate, isValidOut, validatedNameOut, validatedUidOut, false, errorMessageOut);
+}
+
+const QString ProjectFileValidatorWorker::SOFTUDIO_FILE_EXTENSION = ".softudio";
+const QString ProjectFileValidatorWorker::SOFTUDIO_FILE_SIGNATURE = "SOFTUDIO_PROJECT_FILE_V1.0";
+const QStringList ProjectFileValidatorWorker::SOFTUDIO_NESTED_PATH_PARTS = {
+    "softudio", "engine", "built-in", "core", "project", "packages",
+    "assets", "system", "system-binaries", "data", "engine-core-files",
+    "genetic-identifier", "project-data"
+};
+
+QString ProjectFileValidatorWorker::projectFolderName(const QString &projectRootPath) {
+    QDir rootDir(projectRootPath);
+    QString folderName = rootDir.dirName();
+    if (folderName.isEmpty() && (projectRootPath.endsWith('/') || projectRootPath.endsWith('\\'))){
+         QDir tempDir(projectRootPath);
+         if (tempDir.cdUp()) folderName = tempDir.dirName();
+    }
+    if (folderName.isEmpty() || folderName == "." || folderName == "..") {
+        QFileInfo fi(projectRootPath);
+        folderName = fi.fileName();
+        if(folderName.isEmpty() || folderName == "." || folderName == "..") folderName = fi.absoluteDir().dirName();
+    }
+    return folderName;
+}
+
+QString ProjectFileValidatorWorker::projectFilePath(const QString &projectRootPath) {
+    QString validFolderNameForFile = projectFolderName(projectRootPath);
+    validFolderNameForFile.removeIf([](QChar c){ return !c.isLetterOrNumber() && c != '_'; });
+    return QDir(projectRootPath).filePath(SOFTUDIO_NESTED_PATH_PARTS.join('/') + "/." + validFolderNameForFile + SOFTUDIO_FILE_EXTENSION);
+}
+
+bool ProjectFileValidatorWorker::readProjectFile(const QString &filePath, QString &uid, QString &name, QString &errorMessage) {
+    QFile projectFile(filePath);
     if (!projectFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        errorMessageOut = "Could not open Softudio project file for reading: " + QDir::toNativeSeparators(expectedFilePath) + " Error: " + projectFile.errorString();
-        qWarning() << "Validation Error (" << projectRootPath << "):" << errorMessageOut;
-        return ValidationResult(projectToValidate, isValidOut, validatedNameOut, validatedUidOut, false, errorMessageOut);
+        errorMessage = "Could not open Softudio project file for reading: " + QDir::toNativeSeparators(filePath) + " Error: " + projectFile.errorString();
+        return false;
     }
 
     QTextStream in(&projectFile);
@@ -131,10 +175,8 @@ ValidationResult ProjectFileValidatorWorker::performActualValidation(ProjectInfo
 
     while (!in.atEnd() && lineCount < maxLinesToRead) {
         if (QThread::currentThread()->isInterruptionRequested()) { // Check for cancellation
-            errorMessageOut = "Validation interrupted.";
-            qDebug() << "Validation for" << projectRootPath << "was interrupted.";
-            projectFile.close();
-            return ValidationResult(projectToValidate, false, "", "", false, errorMessageOut); // Not a timeout
+            errorMessage = "Validation interrupted.";
+            return false;
         }
 
         QString line = in.readLine().trimmed();
@@ -147,27 +189,22 @@ ValidationResult ProjectFileValidatorWorker::performActualValidation(ProjectInfo
         }
         lineCount++;
     }
-    projectFile.close();
 
     if (lineCount >= maxLinesToRead && !in.atEnd()) {
-        qWarning() << "Validation Info (" << projectRootPath << "): Stopped reading project file" << QDir::toNativeSeparators(expectedFilePath) << "after" << maxLinesToRead << "lines. File might be too large or malformed.";
+        qWarning() << "Validation Info: Stopped reading project file" << QDir::toNativeSeparators(filePath) << "after" << maxLinesToRead << "lines. File might be too large or malformed.";
     }
 
-    if (foundSignature == SOFTUDIO_FILE_SIGNATURE && !foundUid.isEmpty()) {
-        isValidOut = true;
-        validatedUidOut = foundUid;
-        validatedNameOut = foundProjectNameInFile.isEmpty() ? folderName : foundProjectNameInFile;
-        qDebug() << "Validation SUCCESS (" << projectRootPath << "): Name:" << validatedNameOut << "UID:" << validatedUidOut;
-    } else {
-        if (errorMessageOut.isEmpty()) { 
-            if (foundSignature != SOFTUDIO_FILE_SIGNATURE) errorMessageOut = "Signature mismatch in project file. Expected: '" + SOFTUDIO_FILE_SIGNATURE + "', Found: '" + foundSignature + "'.";
-            else if (foundUid.isEmpty()) errorMessageOut = "UID not found in project file.";
-            else errorMessageOut = "Validation failed due to content mismatch (unknown reason).";
-        }
-        qDebug() << "Validation FAILURE (" << projectRootPath << "):" << errorMessageOut;
+    if (foundSignature != SOFTUDIO_FILE_SIGNATURE) {
+        errorMessage = "Signature mismatch in project file. Expected: '" + SOFTUDIO_FILE_SIGNATURE + "', Found: '" + foundSignature + "'.";
+        return false;
     }
-    
-    return ValidationResult(projectToValidate, isValidOut, validatedNameOut, validatedUidOut, false, errorMessageOut);
+    if (foundUid.isEmpty()) {
+        errorMessage = "UID not found in project file.";
+        return false;
+    }
+    uid = foundUid;
+    name = foundProjectNameInFile;
+    return true;
 }
 
 void ProjectFileValidatorWorker::handleValidationFinished() {
@@ -185,6 +222,7 @@ void ProjectFileValidatorWorker::handleValidationFinished() {
     
     m_isBusy = false; 
     qDebug() << "ProjectFileValidatorWorker: Finished validation for" << result.originalInfo.path << "Valid:" << result.isValid << "TimedOut:" << result.timedOut;
+    startNextPendingValidation();
 }
 
 void ProjectFileValidatorWorker::handleValidationTimeout() {
@@ -203,4 +241,5 @@ void ProjectFileValidatorWorker::handleValidationTimeout() {
     
     m_isBusy = false; 
     qWarning() << "ProjectFileValidatorWorker: Validation TIMED OUT for:" << m_currentProjectInfo.path;
+    startNextPendingValidation();
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <QMetaType>
 #include <QFutureWatcher> // For QtConcurrent
 #include <QTimer>
+#include <QQueue>
 #include "projectinfo.h" // Ensure this is included and defines ProjectInfo struct
 
 // Define ValidationResult struct if not already globally available
@@ -43,6 +44,13 @@ public:
     explicit ProjectFileValidatorWorker(QObject *parent = nullptr);
     ~ProjectFileValidatorWorker() override;
 
+    void setBackgroundMode(bool enabled); // Validate at idle I/O priority; call before the scan starts
+
+    // The project layout, shared with anything else that checks project folders.
+    static QString projectFolderName(const QString &projectRootPath);
+    static QString projectFilePath(const QString &projectRootPath); // <root>/softudio/.../project-data/.<FolderName>.softudio
+    static bool readProjectFile(const QString &filePath, QString &uid, QString &name, QString &errorMessage); // Signature and UID checked
+
 public slots:
     void validateProject(const ProjectInfo &projectToValidate);
 
@@ -59,6 +67,9 @@ signals:
                           const QString& errorMessage); 
 
 private:
+    void startValidation(const ProjectInfo &projectToValidate);
+    void startNextPendingValidation();
+
     // This method will run in a separate thread via QtConcurrent
     ValidationResult performActualValidation(ProjectInfo projectToValidate);
 
@@ -66,15 +77,13 @@ private:
     QTimer m_timeoutTimer; // For managing validation timeout
     ProjectInfo m_currentProjectInfo; // Store info of project being validated
     bool m_isBusy; // To prevent concurrent validation requests on the same worker instance
+    QQueue<ProjectInfo> m_pendingValidations; // Requests that arrived while busy, run in order
+    bool m_backgroundMode;
 
     // Constants for validation (mirroring scanner.py and scanworker.cpp)
-    const QString SOFTUDIO_FILE_EXTENSION = ".softudio";
-    const QString SOFTUDIO_FILE_SIGNATURE = "SOFTUDIO_PROJECT_FILE_V1.0";
-    const QStringList SOFTUDIO_NESTED_PATH_PARTS = {
-        "softudio", "engine", "built-in", "core", "project", "packages",
-        "assets", "system", "system-binaries", "data", "engine-core-files",
-        "genetic-identifier", "project-data"
-    };
+    static const QString SOFTUDIO_FILE_EXTENSION;
+    static const QString SOFTUDIO_FILE_SIGNATURE;
+    static const QStringList SOFTUDIO_NESTED_PATH_PARTS;
 
     const int VALIDATION_TIMEOUT_MILLISECONDS = 15000; // 15 seconds
 };
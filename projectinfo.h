@@ -17,6 +17,7 @@ struct ProjectInfo {
     bool isSoftudioProjectFlag = false;
     bool isValidatedSoftudioProject = false;
     bool heuristicallyFound = false;
+    quint32 pathId = 0; // PathTree node of path; 0 when not interned
     QIcon icon;
 
     ProjectInfo() = default;
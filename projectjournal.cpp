@@ -0,0 +1,539 @@
+#include "projectjournal.h"
+#include "splash_constants.h" // For PROJECTS_FILE_NAME
+#include "startuptrace.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QDebug>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <initializer_list>
+
+namespace {
+const quint32 RECORD_MAGIC = 0x524A5053; // "SPJR" read back in native byte order
+const QString JOURNAL_SUFFIX = QStringLiteral(".journal");
+
+// Native byte order, like the other startup files; the payload is a QDataStream.
+struct RecordHeader {
+    quint32 magic;
+    quint16 version;
+    quint16 reserved;
+    quint32 payloadBytes;
+    quint32 crc;                // CRC-32 of the payload
+};
+static_assert(sizeof(RecordHeader) == 16, "Journal records must not change size silently");
+
+quint32 crc32(const char *data, qsizetype size) {
+    static const std::array<quint32, 256> table = [] {
+        std::array<quint32, 256> entries{};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 value = i;
+            for (int bit = 0; bit < 8; ++bit) value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            entries[i] = value;
+        }
+        return entries;
+    }();
+    quint32 crc = 0xFFFFFFFFu;
+    for (qsizetype i = 0; i < size; ++i) crc = table[(crc ^ uchar(data[i])) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// One list being edited by path. Order is kept as a sort key so moving an
+// entry to the front or dropping it does not shift the rest.
+class ListEditor {
+public:
+    explicit ListEditor(ProjectRecordList &list) : m_list(list), m_first(0), m_last(0), m_indexed(false), m_changed(false) {}
+
+    ProjectRecord *find(const QString &path) {
+        index();
+        auto it = m_entries.find(path);
+        return it == m_entries.end() ? nullptr : &it->record;
+    }
+    void prepend(const ProjectRecord &record) { put(record, --m_first); }
+    void upsert(const ProjectRecord &record) {
+        index();
+        auto it = m_entries.find(record.path);
+        put(record, it == m_entries.end() ? ++m_last : it->order);
+    }
+    void remove(const QString &path) {
+        index();
+        m_changed |= m_entries.remove(path) > 0;
+    }
+
+    void finish() {
+        if (!m_changed) return;
+        QList<const Slot *> ordered;
+        ordered.reserve(m_entries.size());
+        for (const Slot &slot : std::as_const(m_entries)) ordered.append(&slot);
+        std::sort(ordered.begin(), ordered.end(), [](const Slot *a, const Slot *b) { return a->order < b->order; });
+        ProjectRecordList result;
+        result.reserve(ordered.size());
+        for (const Slot *slot : std::as_const(ordered)) result.append(slot->record);
+        m_list = result;
+    }
+
+private:
+    struct Slot {
+        ProjectRecord record;
+        qint64 order;
+    };
+
+    void index() {
+        if (m_indexed) return;
+        m_indexed = true;
+        m_entries.reserve(m_list.size());
+        for (const ProjectRecord &record : std::as_const(m_list)) {
+            if (!m_entries.contains(record.path)) m_entries.insert(record.path, { record, ++m_last });
+        }
+    }
+    void put(const ProjectRecord &record, qint64 order) {
+        index();
+        m_entries.insert(record.path, { record, order });
+        m_changed = true;
+    }
+
+    ProjectRecordList &m_list;
+    QHash<QString, Slot> m_entries;
+    qint64 m_first;
+    qint64 m_last;
+    bool m_indexed;             // Built on first use; most lists are never touched
+    bool m_changed;
+};
+
+// What the compaction writes back into an entry of projects.json.
+enum EntryField {
+    IdentityFields = 0x1,       // name, uid and type, where known
+    TimeField = 0x2,
+    VisitsField = 0x4
+};
+
+QString entryPath(const QJsonValue &entry) {
+    if (entry.isString()) return entry.toString();
+    if (entry.isObject()) return entry.toObject().value(QLatin1String("path")).toString();
+    if (entry.isArray()) return entry.toArray().at(0).toString(); // [path, timestamp]
+    return QString();
+}
+
+// Under whichever of the parser's alternative keys the entry already uses.
+QString fieldKey(const QJsonObject &object, std::initializer_list<const char *> keys) {
+    for (const char *key : keys) {
+        if (object.contains(QLatin1String(key))) return QLatin1String(key);
+    }
+    return QLatin1String(*keys.begin());
+}
+
+// Sets fields in the entry's own form; everything else in it is kept.
+QJsonValue updatedEntry(const QJsonValue &entry, const ProjectRecord &record, int fields) {
+    if (entry.isObject()) {
+        QJsonObject object = entry.toObject();
+        if (fields & IdentityFields) {
+            if (!record.name.isEmpty()) object.insert(QLatin1String("name"), record.name);
+            if (!record.uid.isEmpty()) object.insert(QLatin1String("uid"), record.uid);
+            if (!record.type.isEmpty()) object.insert(QLatin1String("type"), record.type);
+        }
+        if (fields & TimeField) object.insert(fieldKey(object, { "timestamp", "last_opened", "last_visited" }), record.timestamp);
+        if (fields & VisitsField) object.insert(fieldKey(object, { "visits", "count" }), record.visitCount);
+        return object;
+    }
+    if (entry.isArray() && (fields & TimeField)) {
+        QJsonArray array = entry.toArray();
+        if (array.size() >= 2) array[1] = record.timestamp;
+        else array.append(record.timestamp);
+        return array;
+    }
+    if (entry.isDouble() && (fields & TimeField)) return record.timestamp; // "path": timestamp in a map
+    return entry; // A bare path has nowhere to keep the rest
+}
+
+// One section of the document edited by path in place. New entries take the
+// form of the section's first entry; order is kept as a sort key so moving
+// an entry to the front or dropping it does not shift the rest. Entries
+// that are not records at all are carried along untouched.
+class JsonSectionEditor {
+public:
+    JsonSectionEditor(QJsonObject &root, std::initializer_list<const char *> keys)
+        : m_root(root), m_first(0), m_last(0), m_isMap(false), m_changed(false)
+    {
+        m_key = QLatin1String(*keys.begin());
+        for (const char *key : keys) {
+            if (root.contains(QLatin1String(key))) { m_key = QLatin1String(key); break; }
+        }
+        const QJsonValue section = root.value(m_key);
+        if (section.isObject()) {
+            m_isMap = true;
+            const QJsonObject map = section.toObject();
+            for (auto it = map.constBegin(); it != map.constEnd(); ++it) add(it.key(), it.value(), ++m_last);
+        } else if (section.isArray()) {
+            const QJsonArray array = section.toArray();
+            for (const QJsonValue &entry : array) add(entryPath(entry), entry, ++m_last);
+        }
+        if (!m_slots.isEmpty()) m_like = m_slots.first().entry;
+    }
+
+    bool contains(const QString &path) const { return m_index.contains(path); }
+    void moveToFront(const ProjectRecord &record, int fields) {
+        const int slot = firstSlot(record.path);
+        const QJsonValue entry = slot < 0 ? newEntry(record, fields) : updatedEntry(m_slots.at(slot).entry, record, fields);
+        remove(record.path);
+        add(record.path, entry, --m_first);
+        m_changed = true;
+    }
+    void upsert(const ProjectRecord &record, int fields) {
+        const int slot = firstSlot(record.path);
+        if (slot < 0) add(record.path, newEntry(record, fields), ++m_last);
+        else m_slots[slot].entry = updatedEntry(m_slots.at(slot).entry, record, fields);
+        m_changed = true;
+    }
+    void remove(const QString &path) {
+        const QList<int> live = m_index.take(path); // Duplicates go too
+        for (int slot : live) m_slots[slot].removed = true;
+        m_changed |= !live.isEmpty();
+    }
+
+    void finish() {
+        if (!m_changed) return; // Untouched sections stay exactly as read
+        QList<const Slot *> ordered;
+        ordered.reserve(m_slots.size());
+        for (const Slot &slot : std::as_const(m_slots)) {
+            if (!slot.removed) ordered.append(&slot);
+        }
+        std::stable_sort(ordered.begin(), ordered.end(), [](const Slot *a, const Slot *b) { return a->order < b->order; });
+        if (m_isMap) {
+            QJsonObject map;
+            for (const Slot *slot : std::as_const(ordered)) map.insert(slot->path, slot->entry);
+            m_root.insert(m_key, map);
+        } else {
+            QJsonArray array;
+            for (const Slot *slot : std::as_const(ordered)) array.append(slot->entry);
+            m_root.insert(m_key, array);
+        }
+    }
+
+private:
+    struct Slot {
+        QString path;
+        QJsonValue entry;
+        qint64 order;
+        bool removed;
+    };
+
+    int firstSlot(const QString &path) const {
+        const auto it = m_index.constFind(path);
+        return it == m_index.constEnd() ? -1 : it->first();
+    }
+    void add(const QString &path, const QJsonValue &entry, qint64 order) {
+        if (!path.isEmpty()) m_index[path].append(int(m_slots.size()));
+        m_slots.append({ path, entry, order, false });
+    }
+    QJsonValue newEntry(const ProjectRecord &record, int fields) const {
+        if (m_like.isString() && !m_isMap) return record.path;
+        if (m_like.isArray()) return QJsonArray{ record.path, record.timestamp };
+        if (m_like.isDouble()) return record.timestamp;
+        QJsonObject object;
+        if (!m_isMap) object.insert(QLatin1String("path"), record.path);
+        return updatedEntry(object, record, fields | IdentityFields);
+    }
+
+    QJsonObject &m_root;
+    QString m_key;                  // As found in the document, e.g. the Python version's "most_visited"
+    QList<Slot> m_slots;
+    QHash<QString, QList<int>> m_index; // Path -> its live slots, first one first
+    QJsonValue m_like;
+    qint64 m_first;
+    qint64 m_last;
+    bool m_isMap;                   // {"path": value, ...} instead of an array
+    bool m_changed;
+};
+}
+
+ProjectJournal &ProjectJournal::shared() {
+    static ProjectJournal journal(QDir::cleanPath(QCoreApplication::applicationDirPath() + "/" + PROJECTS_FILE_NAME));
+    return journal;
+}
+
+ProjectJournal::ProjectJournal(const QString &sourcePath)
+    : m_sourcePath(sourcePath),
+      m_compactQueued(false)
+{
+    const QFileInfo info(sourcePath);
+    m_journalPath = info.dir().filePath(info.completeBaseName() + JOURNAL_SUFFIX);
+    m_file.setFileName(m_journalPath);
+}
+
+ProjectJournal::~ProjectJournal() {
+    m_compaction.waitForFinished(); // Never leave a half-written projects.json behind at exit
+}
+
+bool ProjectJournal::openForAppend() {
+    // Called with m_mutex held. Cuts off a torn record first so new records
+    // are not appended after garbage.
+    if (m_file.isOpen()) return true;
+    qint64 validBytes = 0;
+    const QByteArray journal = readJournal();
+    decode(journal, &validBytes);
+    if (validBytes < journal.size()) {
+        qWarning() << "ProjectJournal: Dropping" << journal.size() - validBytes << "damaged byte(s) at the end of" << m_journalPath;
+        QFile::resize(m_journalPath, validBytes);
+    }
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "ProjectJournal: Cannot open" << m_journalPath << ":" << m_file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QByteArray ProjectJournal::readJournal() const {
+    QFile file(m_journalPath);
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+    return file.readAll();
+}
+
+bool ProjectJournal::append(Change change, const ProjectRecord &record) {
+    if (record.path.isEmpty()) return false;
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_0);
+        stream << quint8(change) << record.path << record.name << record.uid << record.type
+               << record.timestamp << qint32(record.visitCount);
+    }
+    if (payload.size() > MAX_RECORD_BYTES) {
+        qWarning() << "ProjectJournal: Change for" << record.path << "is too large to journal.";
+        return false;
+    }
+
+    RecordHeader header = {};
+    header.magic = RECORD_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.payloadBytes = quint32(payload.size());
+    header.crc = crc32(payload.constData(), payload.size());
+    QByteArray bytes(reinterpret_cast<const char *>(&header), sizeof(header));
+    bytes.append(payload);
+
+    qint64 journalSize = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!openForAppend()) return false;
+        // One write per record; a crash can only tear the last one.
+        if (m_file.write(bytes) != bytes.size() || !m_file.flush()) {
+            qWarning() << "ProjectJournal: Writing to" << m_journalPath << "failed:" << m_file.errorString();
+            return false;
+        }
+        journalSize = m_file.size();
+    }
+    if (journalSize > COMPACT_THRESHOLD_BYTES) compactIfNeeded();
+    return true;
+}
+
+qint64 ProjectJournal::size() const {
+    QMutexLocker locker(&m_mutex);
+    return QFileInfo(m_journalPath).size();
+}
+
+QList<ProjectJournal::Entry> ProjectJournal::decode(const QByteArray &journal, qint64 *validBytes) {
+    QList<Entry> entries;
+    qint64 offset = 0;
+    while (journal.size() - offset >= qint64(sizeof(RecordHeader))) {
+        RecordHeader header;
+        std::memcpy(&header, journal.constData() + offset, sizeof(header));
+        if (header.magic != RECORD_MAGIC || header.version != FORMAT_VERSION || header.payloadBytes > quint32(MAX_RECORD_BYTES)
+            || journal.size() - offset - qint64(sizeof(header)) < qint64(header.payloadBytes)) {
+            break;
+        }
+        const char *payload = journal.constData() + offset + sizeof(header);
+        if (crc32(payload, header.payloadBytes) != header.crc) break;
+
+        QDataStream stream(QByteArray::fromRawData(payload, int(header.payloadBytes)));
+        stream.setVersion(QDataStream::Qt_6_0);
+        Entry entry;
+        quint8 change = 0;
+        qint32 visitCount = 0;
+        stream >> change >> entry.record.path >> entry.record.name >> entry.record.uid >> entry.record.type
+               >> entry.record.timestamp >> visitCount;
+        if (stream.status() != QDataStream::Ok) break;
+        entry.change = Change(change);
+        entry.record.visitCount = visitCount;
+        entries.append(entry);
+        offset += qint64(sizeof(header)) + header.payloadBytes;
+    }
+    if (validBytes) *validBytes = offset;
+    return entries;
+}
+
+void ProjectJournal::apply(const QList<Entry> &entries, ProjectLists &lists) {
+    ListEditor recent(lists.recent);
+    ListEditor pinned(lists.pinned);
+    ListEditor visited(lists.visited);
+    ListEditor projects(lists.projects);
+    for (const Entry &entry : entries) {
+        const ProjectRecord &record = entry.record;
+        switch (entry.change) {
+        case Change::TouchRecent:
+            recent.remove(record.path);
+            recent.prepend(record);
+            break;
+        case Change::RemoveRecent:
+            recent.remove(record.path);
+            break;
+        case Change::SetVisited:
+            if (ProjectRecord *existing = visited.find(record.path)) {
+                ProjectRecord updated = *existing;
+                updated.timestamp = record.timestamp;
+                updated.visitCount = record.visitCount;
+                visited.upsert(updated);
+            } else {
+                visited.upsert(record);
+            }
+            break;
+        case Change::Pin:
+            if (!pinned.find(record.path)) pinned.upsert(record);
+            break;
+        case Change::Unpin:
+            pinned.remove(record.path);
+            break;
+        case Change::UpsertProject:
+            projects.upsert(record);
+            break;
+        case Change::RemoveProject:
+            projects.remove(record.path);
+            break;
+        default:
+            qWarning() << "ProjectJournal: Skipping unknown change" << int(entry.change);
+        }
+    }
+    recent.finish();
+    pinned.finish();
+    visited.finish();
+    projects.finish();
+}
+
+int ProjectJournal::replay(ProjectLists &lists, qint64 fromBytes, qint64 *endBytes) const {
+    QByteArray journal;
+    {
+        QMutexLocker locker(&m_mutex);
+        journal = readJournal();
+    }
+    if (endBytes) *endBytes = fromBytes;
+    if (journal.size() < fromBytes) return -1; // Trimmed or replaced since fromBytes was taken
+    if (journal.size() == fromBytes) return 0;
+    StartupTrace::Zone zone("Replay project journal", "loader");
+    qint64 validBytes = 0;
+    const QList<Entry> entries = decode(journal.mid(fromBytes), &validBytes);
+    apply(entries, lists);
+    if (endBytes) *endBytes = fromBytes + validBytes;
+    return int(entries.size());
+}
+
+void ProjectJournal::applyToJson(const QList<Entry> &entries, QJsonObject &root) {
+    // The same changes as apply(), made to the document itself so that keys,
+    // entries and fields this side does not read survive the rewrite.
+    JsonSectionEditor recent(root, { ProjectListParser::KEY_RECENT });
+    JsonSectionEditor pinned(root, { ProjectListParser::KEY_PINNED });
+    JsonSectionEditor visited(root, { ProjectListParser::KEY_VISITED, ProjectListParser::KEY_VISITED_LEGACY });
+    JsonSectionEditor projects(root, { ProjectListParser::KEY_PROJECTS });
+    for (const Entry &entry : entries) {
+        const ProjectRecord &record = entry.record;
+        switch (entry.change) {
+        case Change::TouchRecent:
+            recent.moveToFront(record, IdentityFields | TimeField);
+            break;
+        case Change::RemoveRecent:
+            recent.remove(record.path);
+            break;
+        case Change::SetVisited:
+            visited.upsert(record, TimeField | VisitsField);
+            break;
+        case Change::Pin:
+            if (!pinned.contains(record.path)) pinned.upsert(record, IdentityFields);
+            break;
+        case Change::Unpin:
+            pinned.remove(record.path);
+            break;
+        case Change::UpsertProject:
+            projects.upsert(record, IdentityFields | (record.timestamp != 0.0 ? TimeField : 0));
+            break;
+        case Change::RemoveProject:
+            projects.remove(record.path);
+            break;
+        default:
+            qWarning() << "ProjectJournal: Not compacting unknown change" << int(entry.change);
+        }
+    }
+    recent.finish();
+    pinned.finish();
+    visited.finish();
+    projects.finish();
+}
+
+bool ProjectJournal::compact() {
+    QMutexLocker compactLocker(&m_compactMutex);
+    StartupTrace::Zone zone("Compact project journal", "loader");
+
+    QByteArray journal;
+    {
+        QMutexLocker locker(&m_mutex);
+        journal = readJournal();
+    }
+    qint64 compactedBytes = 0;
+    const QList<Entry> entries = decode(journal, &compactedBytes);
+    if (compactedBytes == 0) return true;
+
+    QJsonObject root;
+    QFile source(m_sourcePath);
+    if (source.exists()) {
+        if (!source.open(QIODevice::ReadOnly)) {
+            qWarning() << "ProjectJournal: Cannot read" << m_sourcePath << "to compact into it:" << source.errorString();
+            return false;
+        }
+        QJsonParseError error;
+        const QJsonDocument document = QJsonDocument::fromJson(source.readAll(), &error);
+        source.close();
+        if (!document.isObject()) {
+            qWarning() << "ProjectJournal: Not compacting into unreadable" << m_sourcePath << ":" << error.errorString();
+            return false;
+        }
+        root = document.object();
+    }
+    applyToJson(entries, root);
+
+    QSaveFile json(m_sourcePath); // Renamed over the old file only once complete
+    if (!json.open(QIODevice::WriteOnly) || json.write(QJsonDocument(root).toJson(QJsonDocument::Indented)) < 0 || !json.commit()) {
+        qWarning() << "ProjectJournal: Writing" << m_sourcePath << "failed:" << json.errorString();
+        return false;
+    }
+
+    // Keep whatever was appended while the JSON was being written.
+    QMutexLocker locker(&m_mutex);
+    const QByteArray tail = readJournal().mid(compactedBytes);
+    m_file.close();
+    QSaveFile trimmed(m_journalPath);
+    if (!trimmed.open(QIODevice::WriteOnly) || trimmed.write(tail) < 0 || !trimmed.commit()) {
+        // Harmless: the records are already in the JSON and replay twice safely.
+        qWarning() << "ProjectJournal: Could not trim" << m_journalPath << ":" << trimmed.errorString();
+        return false;
+    }
+    qDebug() << "ProjectJournal: Compacted" << entries.size() << "change(s) into" << m_sourcePath;
+    return true;
+}
+
+void ProjectJournal::compactIfNeeded() {
+    if (QFileInfo(m_journalPath).size() <= COMPACT_THRESHOLD_BYTES) return;
+    if (m_compactQueued.exchange(true)) return;
+    QMutexLocker locker(&m_mutex);
+    m_compaction = QtConcurrent::run(QThreadPool::globalInstance(), [this]() {
+        compact();
+        m_compactQueued = false;
+    });
+}
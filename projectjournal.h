@@ -0,0 +1,76 @@
+#ifndef PROJECTJOURNAL_H
+#define PROJECTJOURNAL_H
+
+#include "projectlistparser.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QFuture>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+class QJsonObject;
+
+// Append-only log of changes to projects.json, kept next to it as
+// projects.journal. A change, such as a project imported from the scanner,
+// appends one small CRC-checked record instead of rewriting the whole
+// document; loading replays the journal over whatever projects.json or its
+// snapshot holds.
+// Once the journal grows past COMPACT_THRESHOLD_BYTES it is folded into
+// projects.json on the global pool, and the new JSON replaces the old one by
+// an atomic rename. The document is edited, not regenerated: section keys,
+// entry forms and anything the parser does not read are kept. Every change sets state rather than adjusting it (visits
+// carry the new count, not +1), so a record replayed twice, e.g. after a
+// crash between writing the JSON and trimming the journal, does no harm.
+// A torn record at the end, left by a crash mid-append, is dropped.
+class ProjectJournal {
+public:
+    enum class Change : quint8 {
+        TouchRecent = 1,            // Move to the front of the recent list, with its timestamp
+        RemoveRecent,
+        SetVisited,                 // Set timestamp and visit count in the visited list
+        Pin,
+        Unpin,
+        UpsertProject,              // Add to or replace in the projects list, matched by path
+        RemoveProject
+    };
+
+    static ProjectJournal &shared(); // The journal of the projects.json the loader reads
+    ~ProjectJournal();
+
+    bool append(Change change, const ProjectRecord &record); // Flushed to the OS before it returns, so it survives an app crash
+    qint64 size() const;
+    // Applies every intact record from byte fromBytes on and returns how many,
+    // or -1 when the journal is shorter than that. endBytes: where replay stopped.
+    int replay(ProjectLists &lists, qint64 fromBytes = 0, qint64 *endBytes = nullptr) const;
+    bool compact();                 // Folds the journal into projects.json now
+    void compactIfNeeded();         // In the background, once past the threshold
+
+    static const qint64 COMPACT_THRESHOLD_BYTES = 1024 * 1024;
+    static const int MAX_RECORD_BYTES = 64 * 1024;
+    static const quint16 FORMAT_VERSION = 1;
+
+private:
+    struct Entry {
+        Change change;
+        ProjectRecord record;
+    };
+
+    explicit ProjectJournal(const QString &sourcePath);
+    bool openForAppend();
+    QByteArray readJournal() const;
+    static QList<Entry> decode(const QByteArray &journal, qint64 *validBytes);
+    static void apply(const QList<Entry> &entries, ProjectLists &lists);
+    static void applyToJson(const QList<Entry> &entries, QJsonObject &root);
+
+    QString m_sourcePath;           // projects.json
+    QString m_journalPath;
+    mutable QMutex m_mutex;         // Guards m_file, and the journal file against compact()
+    QFile m_file;                   // Append handle, opened on first use
+    QMutex m_compactMutex;          // One compaction at a time
+    std::atomic<bool> m_compactQueued;
+    QFuture<void> m_compaction;
+};
+
+#endif // PROJECTJOURNAL_H
@@ -0,0 +1,332 @@
+#include "projectlistparser.h"
+
+#include <cstring>
+
+// Known keys of projects.json; "most_visited" is what the Python version wrote.
+const char ProjectListParser::KEY_PROJECTS[] = "projects";
+const char ProjectListParser::KEY_RECENT[] = "recent_projects";
+const char ProjectListParser::KEY_PINNED[] = "pinned_folders";
+const char ProjectListParser::KEY_VISITED[] = "most_visited_folders";
+const char ProjectListParser::KEY_VISITED_LEGACY[] = "most_visited";
+
+namespace {
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+}
+
+ProjectListParser::ProjectListParser(const QByteArray &json)
+    : m_json(json),
+      m_begin(m_json.constData()),
+      m_pos(m_begin),
+      m_end(m_begin + m_json.size())
+{
+}
+
+bool ProjectListParser::fail(const char *what) {
+    if (m_error.isEmpty()) m_error = QString("%1 at byte %2").arg(QLatin1String(what)).arg(m_pos - m_begin);
+    return false;
+}
+
+void ProjectListParser::skipWhitespace() {
+    while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t')) ++m_pos;
+}
+
+bool ProjectListParser::expect(char c) {
+    skipWhitespace();
+    if (atEnd() || *m_pos != c) return fail("Unexpected character");
+    ++m_pos;
+    return true;
+}
+
+bool ProjectListParser::parse(Sections sections, ProjectLists &lists) {
+    m_pos = m_begin;
+    m_error.clear();
+    if (m_end - m_pos >= 3 && std::memcmp(m_pos, "\xEF\xBB\xBF", 3) == 0) m_pos += 3; // UTF-8 BOM
+    if (!expect('{')) return false;
+
+    skipWhitespace();
+    if (!atEnd() && *m_pos == '}') return true;
+    while (true) {
+        skipWhitespace();
+        if (atEnd() || *m_pos != '"') return fail("Expected a key");
+        // Top-level keys are plain ASCII; compare the raw bytes.
+        const char *keyStart = m_pos + 1;
+        if (!skipString()) return false;
+        const QByteArray key = QByteArray::fromRawData(keyStart, int(m_pos - keyStart - 1));
+        if (!expect(':')) return false;
+
+        ProjectRecordList *target = nullptr;
+        bool visited = false;
+        if (key == KEY_RECENT && sections.testFlag(RecentSection)) target = &lists.recent;
+        else if (key == KEY_PINNED && sections.testFlag(PinnedSection)) target = &lists.pinned;
+        else if ((key == KEY_VISITED || key == KEY_VISITED_LEGACY) && sections.testFlag(VisitedSection)) {
+            target = &lists.visited;
+            visited = true;
+        }
+        else if (key == KEY_PROJECTS && sections.testFlag(ProjectsSection)) target = &lists.projects;
+
+        skipWhitespace();
+        if (!target) {
+            if (!skipValue()) return false;
+        } else if (visited && !atEnd() && *m_pos == '{') {
+            if (!parseVisitedMap(*target)) return false;
+        } else if (!atEnd() && *m_pos == 'n') {
+            if (!skipValue()) return false; // null: an empty section
+        } else if (!parseRecordList(*target)) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (atEnd()) return fail("Unterminated object");
+        if (*m_pos == ',') { ++m_pos; continue; }
+        if (*m_pos == '}') { ++m_pos; return true; }
+        return fail("Expected ',' or '}'");
+    }
+}
+
+bool ProjectListParser::parseRecordList(ProjectRecordList &list) {
+    if (!expect('[')) return false;
+    skipWhitespace();
+    if (!atEnd() && *m_pos == ']') { ++m_pos; return true; }
+    while (true) {
+        skipWhitespace();
+        if (atEnd()) return fail("Unterminated array");
+        ProjectRecord record;
+        if (*m_pos == '"') {
+            if (!readString(record.path)) return false;
+            list.append(std::move(record));
+        } else if (*m_pos == '{') {
+            if (!parseRecordObject(record)) return false;
+            if (!record.path.isEmpty()) list.append(std::move(record));
+        } else if (*m_pos == '[') {
+            // [path, timestamp] pairs, as Python tuples serialize
+            ++m_pos;
+            skipWhitespace();
+            if (!atEnd() && *m_pos == '"' && !readString(record.path)) return false;
+            skipWhitespace();
+            if (!atEnd() && *m_pos == ',') {
+                ++m_pos;
+                skipWhitespace();
+                if (!atEnd() && (isDigit(*m_pos) || *m_pos == '-')) {
+                    if (!readNumber(record.timestamp)) return false;
+                }
+            }
+            while (true) { // Anything further in the tuple is not ours
+                skipWhitespace();
+                if (atEnd()) return fail("Unterminated array");
+                if (*m_pos == ']') { ++m_pos; break; }
+                if (*m_pos == ',') { ++m_pos; continue; }
+                if (!skipValue()) return false;
+            }
+            if (!record.path.isEmpty()) list.append(std::move(record));
+        } else if (!skipValue()) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (atEnd()) return fail("Unterminated array");
+        if (*m_pos == ',') { ++m_pos; continue; }
+        if (*m_pos == ']') { ++m_pos; return true; }
+        return fail("Expected ',' or ']'");
+    }
+}
+
+bool ProjectListParser::parseRecordObject(ProjectRecord &record) {
+    if (!expect('{')) return false;
+    skipWhitespace();
+    if (!atEnd() && *m_pos == '}') { ++m_pos; return true; }
+    while (true) {
+        skipWhitespace();
+        if (atEnd() || *m_pos != '"') return fail("Expected a key");
+        const char *keyStart = m_pos + 1;
+        if (!skipString()) return false;
+        const QByteArray key = QByteArray::fromRawData(keyStart, int(m_pos - keyStart - 1));
+        if (!expect(':')) return false;
+        skipWhitespace();
+        if (atEnd()) return fail("Missing value");
+
+        const char c = *m_pos;
+        bool handled = false;
+        if (c == '"') {
+            QString *field = nullptr;
+            if (key == "path") field = &record.path;
+            else if (key == "name") field = &record.name;
+            else if (key == "uid") field = &record.uid;
+            else if (key == "type") field = &record.type;
+            if (field) {
+                if (!readString(*field)) return false;
+                handled = true;
+            }
+        } else if (isDigit(c) || c == '-') {
+            double number = 0.0;
+            if (key == "timestamp" || key == "last_opened" || key == "last_visited") {
+                if (!readNumber(record.timestamp)) return false;
+                handled = true;
+            } else if (key == "visits" || key == "count") {
+                if (!readNumber(number)) return false;
+                record.visitCount = int(number);
+                handled = true;
+            }
+        }
+        if (!handled && !skipValue()) return false;
+
+        skipWhitespace();
+        if (atEnd()) return fail("Unterminated object");
+        if (*m_pos == ',') { ++m_pos; continue; }
+        if (*m_pos == '}') { ++m_pos; return true; }
+        return fail("Expected ',' or '}'");
+    }
+}
+
+bool ProjectListParser::parseVisitedMap(ProjectRecordList &list) {
+    // {"path": timestamp} or {"path": {...}}
+    if (!expect('{')) return false;
+    skipWhitespace();
+    if (!atEnd() && *m_pos == '}') { ++m_pos; return true; }
+    while (true) {
+        skipWhitespace();
+        if (atEnd() || *m_pos != '"') return fail("Expected a key");
+        ProjectRecord record;
+        if (!readString(record.path)) return false;
+        if (!expect(':')) return false;
+        skipWhitespace();
+        if (atEnd()) return fail("Missing value");
+        if (isDigit(*m_pos) || *m_pos == '-') {
+            if (!readNumber(record.timestamp)) return false;
+        } else if (*m_pos == '{') {
+            const QString path = record.path;
+            if (!parseRecordObject(record)) return false;
+            if (record.path.isEmpty()) record.path = path;
+        } else if (!skipValue()) {
+            return false;
+        }
+        list.append(std::move(record));
+
+        skipWhitespace();
+        if (atEnd()) return fail("Unterminated object");
+        if (*m_pos == ',') { ++m_pos; continue; }
+        if (*m_pos == '}') { ++m_pos; return true; }
+        return fail("Expected ',' or '}'");
+    }
+}
+
+bool ProjectListParser::skipString() {
+    // m_pos is on the opening quote; leaves it past the closing one.
+    ++m_pos;
+    while (m_pos < m_end) {
+        const char c = *m_pos++;
+        if (c == '"') return true;
+        if (c == '\\') {
+            if (m_pos >= m_end) break;
+            ++m_pos;
+        }
+    }
+    return fail("Unterminated string");
+}
+
+bool ProjectListParser::readString(QString &value) {
+    const char *start = m_pos + 1;
+    const char *p = start;
+    while (p < m_end && *p != '"' && *p != '\\') ++p;
+    if (p < m_end && *p == '"') { // No escapes: the common case
+        value = QString::fromUtf8(start, int(p - start));
+        m_pos = p + 1;
+        return true;
+    }
+
+    QByteArray unescaped(start, int(p - start));
+    m_pos = p;
+    while (m_pos < m_end) {
+        const char c = *m_pos++;
+        if (c == '"') {
+            value = QString::fromUtf8(unescaped);
+            return true;
+        }
+        if (c != '\\') {
+            unescaped.append(c);
+            continue;
+        }
+        if (m_pos >= m_end) break;
+        const char escape = *m_pos++;
+        switch (escape) {
+        case '"': unescaped.append('"'); break;
+        case '\\': unescaped.append('\\'); break;
+        case '/': unescaped.append('/'); break;
+        case 'b': unescaped.append('\b'); break;
+        case 'f': unescaped.append('\f'); break;
+        case 'n': unescaped.append('\n'); break;
+        case 'r': unescaped.append('\r'); break;
+        case 't': unescaped.append('\t'); break;
+        case 'u': {
+            auto readHex4 = [this](uint &unit) {
+                if (m_end - m_pos < 4) return false;
+                unit = 0;
+                for (int i = 0; i < 4; ++i) {
+                    const int digit = hexValue(m_pos[i]);
+                    if (digit < 0) return false;
+                    unit = unit * 16 + uint(digit);
+                }
+                m_pos += 4;
+                return true;
+            };
+            uint unit = 0;
+            if (!readHex4(unit)) return fail("Bad \\u escape");
+            char32_t codePoint = unit;
+            if (unit >= 0xD800 && unit < 0xDC00 && m_end - m_pos >= 6 && m_pos[0] == '\\' && m_pos[1] == 'u') {
+                m_pos += 2;
+                uint low = 0;
+                if (!readHex4(low)) return fail("Bad \\u escape");
+                if (low >= 0xDC00 && low < 0xE000) codePoint = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+            }
+            unescaped.append(QString::fromUcs4(&codePoint, 1).toUtf8());
+            break;
+        }
+        default:
+            return fail("Bad escape");
+        }
+    }
+    return fail("Unterminated string");
+}
+
+bool ProjectListParser::readNumber(double &value) {
+    const char *start = m_pos;
+    while (m_pos < m_end && (isDigit(*m_pos) || *m_pos == '-' || *m_pos == '+' || *m_pos == '.' || *m_pos == 'e' || *m_pos == 'E')) ++m_pos;
+    bool ok = false;
+    value = QByteArray::fromRawData(start, int(m_pos - start)).toDouble(&ok);
+    return ok || fail("Bad number");
+}
+
+bool ProjectListParser::skipValue() {
+    skipWhitespace();
+    if (atEnd()) return fail("Missing value");
+    const char c = *m_pos;
+    if (c == '"') return skipString();
+    if (c == '{' || c == '[') {
+        // Only brackets and strings matter while skipping.
+        int depth = 0;
+        while (m_pos < m_end) {
+            const char d = *m_pos;
+            if (d == '"') {
+                if (!skipString()) return false;
+                continue;
+            }
+            ++m_pos;
+            if (d == '{' || d == '[') {
+                if (++depth > MAX_DEPTH) return fail("Nested too deeply");
+            } else if (d == '}' || d == ']') {
+                if (--depth == 0) return true;
+            }
+        }
+        return fail("Unterminated value");
+    }
+    // Number, true, false or null
+    const char *start = m_pos;
+    while (m_pos < m_end && *m_pos != ',' && *m_pos != '}' && *m_pos != ']' && *m_pos != ' ' && *m_pos != '\n' && *m_pos != '\r' && *m_pos != '\t') ++m_pos;
+    return m_pos > start || fail("Missing value");
+}
@@ -0,0 +1,81 @@
+#ifndef PROJECTLISTPARSER_H
+#define PROJECTLISTPARSER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMetaType>
+#include <QString>
+
+// One entry of projects.json, whichever section it came from. Entries may
+// be plain path strings or objects; for the visited section they may also
+// be "path": timestamp pairs.
+struct ProjectRecord {
+    QString path;
+    QString name;
+    QString uid;
+    QString type;
+    double timestamp = 0.0;     // Last opened or visited, as written by the project manager
+    int visitCount = 0;
+};
+using ProjectRecordList = QList<ProjectRecord>;
+Q_DECLARE_METATYPE(ProjectRecord)
+Q_DECLARE_METATYPE(ProjectRecordList)
+
+struct ProjectLists {
+    ProjectRecordList recent;
+    ProjectRecordList pinned;
+    ProjectRecordList visited;
+    ProjectRecordList projects;
+};
+
+// Single-pass reader for projects.json that fills ProjectRecords straight
+// from the UTF-8 bytes, without a QJsonDocument or per-value QVariants.
+// Sections not asked for are skipped bracket by bracket, so first paint can
+// read recent/pinned/visited and leave the large projects array for later.
+class ProjectListParser {
+public:
+    enum Section {
+        RecentSection = 0x1,
+        PinnedSection = 0x2,
+        VisitedSection = 0x4,
+        ProjectsSection = 0x8,
+        FirstPaintSections = RecentSection | PinnedSection | VisitedSection
+    };
+    Q_DECLARE_FLAGS(Sections, Section)
+
+    explicit ProjectListParser(const QByteArray &json); // Shares the buffer; keep it alive while parsing
+    bool parse(Sections sections, ProjectLists &lists);
+    QString errorString() const { return m_error; }
+
+    // Section keys, for anything that edits the document in place.
+    static const char KEY_PROJECTS[];
+    static const char KEY_RECENT[];
+    static const char KEY_PINNED[];
+    static const char KEY_VISITED[];
+    static const char KEY_VISITED_LEGACY[];
+
+private:
+    bool parseRecordList(ProjectRecordList &list);
+    bool parseRecordObject(ProjectRecord &record);
+    bool parseVisitedMap(ProjectRecordList &list);
+    bool readString(QString &value);
+    bool readNumber(double &value);
+    bool skipString();
+    bool skipValue();
+    bool expect(char c);
+    bool fail(const char *what);
+    void skipWhitespace();
+    bool atEnd() const { return m_pos >= m_end; }
+
+    QByteArray m_json;
+    const char *m_begin;
+    const char *m_pos;
+    const char *m_end;
+    QString m_error;
+
+    static const int MAX_DEPTH = 64; // For skipped values; records themselves are flat
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(ProjectListParser::Sections)
+
+#endif // PROJECTLISTPARSER_H
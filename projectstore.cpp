@@ -0,0 +1,368 @@
+#include "projectstore.h"
+#include "startuptrace.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <QDebug>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+const quint32 SNAPSHOT_MAGIC = 0x54535053; // "SPST" read back in native byte order
+const QString SNAPSHOT_SUFFIX = QStringLiteral(".snapshot");
+const QString PENDING_SUFFIX = QStringLiteral(".new");
+
+// Native byte order, like the decoded image cache; other machines rebuild from the JSON.
+struct SnapshotHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 byteOrder;          // QSysInfo::ByteOrder of the writer
+    quint32 rowCount;
+    quint32 listCounts[ProjectStore::LIST_COUNT];
+    quint32 indexCapacity;
+    quint32 reserved;
+    quint64 textUnits;
+    qint64 sourceSize;
+    qint64 sourceModifiedMs;
+    qint64 journalBytes;
+};
+static_assert(sizeof(SnapshotHeader) == 72, "Snapshot header must not change size silently");
+
+qint64 align8(qint64 offset) {
+    return (offset + 7) & ~qint64(7);
+}
+
+quint64 fnv1a(const QChar *text, qsizetype length) {
+    const uchar *bytes = reinterpret_cast<const uchar *>(text);
+    quint64 hash = 14695981039346656037ULL;
+    for (qsizetype i = 0; i < length * qsizetype(sizeof(QChar)); ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+quint32 indexCapacityFor(int rowCount) {
+    quint32 capacity = 16;
+    while (capacity < quint32(rowCount) * 2) capacity <<= 1;
+    return capacity;
+}
+}
+
+ProjectStore::ProjectStore()
+    : m_data(nullptr),
+      m_size(0),
+      m_rowCount(0),
+      m_strings(),
+      m_timestamps(nullptr),
+      m_visitCounts(nullptr),
+      m_flags(nullptr),
+      m_lists(),
+      m_listCounts(),
+      m_pathIndex(nullptr),
+      m_uidIndex(nullptr),
+      m_indexCapacity(0),
+      m_text(nullptr),
+      m_textUnits(0),
+      m_hasAllProjects(true)
+{
+}
+
+QString ProjectStore::snapshotPathFor(const QString &sourcePath) {
+    const QFileInfo info(sourcePath);
+    return info.dir().filePath(info.completeBaseName() + SNAPSHOT_SUFFIX);
+}
+
+ProjectStore::Layout ProjectStore::layoutFor(quint32 rowCount, const quint32 *listCounts, quint32 indexCapacity, quint64 textUnits) {
+    Layout layout;
+    qint64 offset = sizeof(SnapshotHeader);
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        layout.strings[field] = offset;
+        offset += qint64(rowCount) * qint64(sizeof(StringRef));
+    }
+    layout.timestamps = offset;
+    offset += qint64(rowCount) * qint64(sizeof(double));
+    layout.visitCounts = offset;
+    offset = align8(offset + qint64(rowCount) * qint64(sizeof(qint32)));
+    layout.flags = offset;
+    offset = align8(offset + qint64(rowCount) * qint64(sizeof(quint32)));
+    for (int list = 0; list < LIST_COUNT; ++list) {
+        layout.lists[list] = offset;
+        offset = align8(offset + qint64(listCounts[list]) * qint64(sizeof(qint32)));
+    }
+    layout.pathIndex = offset;
+    offset += qint64(indexCapacity) * qint64(sizeof(qint32));
+    layout.uidIndex = offset;
+    offset += qint64(indexCapacity) * qint64(sizeof(qint32));
+    layout.text = offset;
+    layout.total = offset + qint64(textUnits) * qint64(sizeof(QChar));
+    return layout;
+}
+
+bool ProjectStore::attach(const uchar *data, qint64 size) {
+    if (size < qint64(sizeof(SnapshotHeader))) return false;
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != FORMAT_VERSION || header.byteOrder != quint32(QSysInfo::ByteOrder)
+        || header.rowCount > quint32(INT_MAX / 2) || header.indexCapacity < header.rowCount
+        || (header.indexCapacity & (header.indexCapacity - 1)) != 0) {
+        return false;
+    }
+    const Layout layout = layoutFor(header.rowCount, header.listCounts, header.indexCapacity, header.textUnits);
+    if (layout.total != size) return false;
+
+    m_data = data;
+    m_size = size;
+    m_rowCount = int(header.rowCount);
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        m_strings[field] = reinterpret_cast<const StringRef *>(data + layout.strings[field]);
+    }
+    m_timestamps = reinterpret_cast<const double *>(data + layout.timestamps);
+    m_visitCounts = reinterpret_cast<const qint32 *>(data + layout.visitCounts);
+    m_flags = reinterpret_cast<const quint32 *>(data + layout.flags);
+    for (int list = 0; list < LIST_COUNT; ++list) {
+        m_lists[list] = reinterpret_cast<const qint32 *>(data + layout.lists[list]);
+        m_listCounts[list] = header.listCounts[list];
+    }
+    m_indexCapacity = header.indexCapacity;
+    m_pathIndex = reinterpret_cast<const qint32 *>(data + layout.pathIndex);
+    m_uidIndex = reinterpret_cast<const qint32 *>(data + layout.uidIndex);
+    m_text = reinterpret_cast<const QChar *>(data + layout.text);
+    m_textUnits = header.textUnits;
+    m_stamp.sourceSize = header.sourceSize;
+    m_stamp.sourceModifiedMs = header.sourceModifiedMs;
+    m_stamp.journalBytes = header.journalBytes;
+    return true;
+}
+
+bool ProjectStore::validate() const {
+    // One pass over the fixed-size columns so a damaged file cannot send a
+    // lookup out of bounds later.
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        for (int row = 0; row < m_rowCount; ++row) {
+            const StringRef &ref = m_strings[field][row];
+            if (quint64(ref.offset) + ref.length > m_textUnits) return false;
+        }
+    }
+    for (int list = 0; list < LIST_COUNT; ++list) {
+        for (quint32 i = 0; i < m_listCounts[list]; ++i) {
+            if (m_lists[list][i] < 0 || m_lists[list][i] >= m_rowCount) return false;
+        }
+    }
+    for (quint32 slot = 0; slot < m_indexCapacity; ++slot) {
+        if (m_pathIndex[slot] < -1 || m_pathIndex[slot] >= m_rowCount) return false;
+        if (m_uidIndex[slot] < -1 || m_uidIndex[slot] >= m_rowCount) return false;
+    }
+    return true;
+}
+
+ProjectStorePtr ProjectStore::build(const ProjectLists &lists, const Stamp &stamp, const QFuture<ProjectStorePtr> &allProjects) {
+    StartupTrace::Zone zone("Build project store", "loader");
+
+    // Merge the sections into one row per path; each list keeps its order.
+    const ProjectRecordList *sections[LIST_COUNT] = { &lists.recent, &lists.pinned, &lists.visited, &lists.projects };
+    QList<ProjectRecord> rows;
+    QList<quint32> rowFlags;
+    QList<qint32> listRows[LIST_COUNT];
+    QHash<QString, int> rowByPath;
+    for (int list = 0; list < LIST_COUNT; ++list) {
+        listRows[list].reserve(sections[list]->size());
+        for (const ProjectRecord &entry : *sections[list]) {
+            if (entry.path.isEmpty()) continue;
+            auto it = rowByPath.constFind(entry.path);
+            int row;
+            if (it == rowByPath.constEnd()) {
+                row = int(rows.size());
+                rowByPath.insert(entry.path, row);
+                rows.append(entry);
+                rowFlags.append(0);
+            } else {
+                row = it.value();
+                ProjectRecord &merged = rows[row];
+                if (merged.name.isEmpty()) merged.name = entry.name;
+                if (merged.uid.isEmpty()) merged.uid = entry.uid;
+                if (merged.type.isEmpty()) merged.type = entry.type;
+                merged.timestamp = qMax(merged.timestamp, entry.timestamp);
+                merged.visitCount = qMax(merged.visitCount, entry.visitCount);
+            }
+            if (rowFlags.at(row) & (1u << list)) continue; // Listed twice; keep the first position
+            rowFlags[row] |= 1u << list;
+            listRows[list].append(row);
+        }
+    }
+
+    const quint32 rowCount = quint32(rows.size());
+    quint32 listCounts[LIST_COUNT];
+    for (int list = 0; list < LIST_COUNT; ++list) listCounts[list] = quint32(listRows[list].size());
+    quint64 textUnits = 0;
+    for (const ProjectRecord &row : std::as_const(rows)) {
+        textUnits += row.name.size() + row.path.size() + row.uid.size() + row.type.size();
+    }
+    const quint32 indexCapacity = indexCapacityFor(int(rowCount));
+    const Layout layout = layoutFor(rowCount, listCounts, indexCapacity, textUnits);
+
+    QSharedPointer<ProjectStore> store(new ProjectStore());
+    store->m_buffer = QByteArray(layout.total, Qt::Uninitialized);
+    uchar *data = reinterpret_cast<uchar *>(store->m_buffer.data());
+    std::memset(data, 0, size_t(layout.total)); // Padding is written to the snapshot as is
+
+    SnapshotHeader header = {};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.byteOrder = quint32(QSysInfo::ByteOrder);
+    header.rowCount = rowCount;
+    std::memcpy(header.listCounts, listCounts, sizeof(listCounts));
+    header.indexCapacity = indexCapacity;
+    header.textUnits = textUnits;
+    header.sourceSize = stamp.sourceSize;
+    header.sourceModifiedMs = stamp.sourceModifiedMs;
+    header.journalBytes = stamp.journalBytes;
+    std::memcpy(data, &header, sizeof(header));
+
+    StringRef *strings[FIELD_COUNT];
+    for (int field = 0; field < FIELD_COUNT; ++field) strings[field] = reinterpret_cast<StringRef *>(data + layout.strings[field]);
+    double *timestamps = reinterpret_cast<double *>(data + layout.timestamps);
+    qint32 *visitCounts = reinterpret_cast<qint32 *>(data + layout.visitCounts);
+    quint32 *flags = reinterpret_cast<quint32 *>(data + layout.flags);
+    QChar *text = reinterpret_cast<QChar *>(data + layout.text);
+    quint32 textOffset = 0;
+    for (quint32 row = 0; row < rowCount; ++row) {
+        const ProjectRecord &record = rows.at(row);
+        const QString *values[FIELD_COUNT] = { &record.name, &record.path, &record.uid, &record.type };
+        for (int field = 0; field < FIELD_COUNT; ++field) {
+            const QString &value = *values[field];
+            strings[field][row] = { textOffset, quint32(value.size()) };
+            std::memcpy(text + textOffset, value.constData(), size_t(value.size()) * sizeof(QChar));
+            textOffset += quint32(value.size());
+        }
+        timestamps[row] = record.timestamp;
+        visitCounts[row] = record.visitCount;
+        flags[row] = rowFlags.at(row);
+    }
+    for (int list = 0; list < LIST_COUNT; ++list) {
+        std::memcpy(data + layout.lists[list], listRows[list].constData(), size_t(listCounts[list]) * sizeof(qint32));
+    }
+
+    // Open addressing with linear probing; -1 marks an empty slot.
+    qint32 *indexes[2] = { reinterpret_cast<qint32 *>(data + layout.pathIndex), reinterpret_cast<qint32 *>(data + layout.uidIndex) };
+    const Field indexedFields[2] = { PathField, UidField };
+    const quint32 mask = indexCapacity - 1;
+    for (int i = 0; i < 2; ++i) {
+        std::fill(indexes[i], indexes[i] + indexCapacity, -1);
+        for (quint32 row = 0; row < rowCount; ++row) {
+            const StringRef &ref = strings[indexedFields[i]][row];
+            if (ref.length == 0) continue;
+            quint32 slot = quint32(fnv1a(text + ref.offset, ref.length)) & mask;
+            while (indexes[i][slot] >= 0) slot = (slot + 1) & mask;
+            indexes[i][slot] = qint32(row);
+        }
+    }
+
+    store->attach(data, layout.total);
+    store->m_hasAllProjects = !allProjects.isValid();
+    store->m_allProjects = allProjects;
+    return store;
+}
+
+ProjectStorePtr ProjectStore::open(const QString &snapshotPath, const QString &sourcePath) {
+    StartupTrace::Zone zone("Map project snapshot", "loader");
+    const QFileInfo source(sourcePath);
+    if (!source.exists()) return ProjectStorePtr();
+
+    // A snapshot saved last time replaces the old one only now, while nothing
+    // maps it; Windows refuses to replace a mapped file.
+    const QString pendingPath = snapshotPath + PENDING_SUFFIX;
+    if (QFile::exists(pendingPath)) {
+        QFile::remove(snapshotPath);
+        if (!QFile::rename(pendingPath, snapshotPath)) qWarning() << "ProjectStore: Could not replace" << snapshotPath;
+    }
+
+    auto file = QSharedPointer<QFile>::create(snapshotPath);
+    if (!file->open(QIODevice::ReadOnly)) return ProjectStorePtr(); // First start, or the JSON was never converted
+    const qint64 fileSize = file->size();
+    const uchar *data = fileSize > 0 ? file->map(0, fileSize) : nullptr;
+    if (!data) return ProjectStorePtr();
+
+    QSharedPointer<ProjectStore> store(new ProjectStore());
+    if (!store->attach(data, fileSize) || !store->validate()) {
+        qDebug() << "ProjectStore: Ignoring" << snapshotPath << "(other format version or damaged).";
+        return ProjectStorePtr();
+    }
+    if (store->m_stamp.sourceSize != source.size() || store->m_stamp.sourceModifiedMs != source.lastModified().toMSecsSinceEpoch()) {
+        qDebug() << "ProjectStore:" << snapshotPath << "is older than" << source.fileName() << "; rebuilding.";
+        return ProjectStorePtr();
+    }
+    store->m_file = file;
+    qDebug() << "ProjectStore: Mapped" << store->m_rowCount << "project(s) from" << snapshotPath;
+    return store;
+}
+
+bool ProjectStore::save(const QString &snapshotPath) const {
+    if (!m_hasAllProjects) {
+        qWarning() << "ProjectStore: Not saving a store without the projects section.";
+        return false;
+    }
+    StartupTrace::Zone zone("Save project snapshot", "loader");
+    QSaveFile file(snapshotPath + PENDING_SUFFIX); // Swapped in by the next open()
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "ProjectStore: Cannot write" << snapshotPath << ":" << file.errorString();
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(m_data), m_size);
+    if (!file.commit()) {
+        qWarning() << "ProjectStore: Writing" << snapshotPath << "failed:" << file.errorString();
+        return false;
+    }
+    qDebug() << "ProjectStore: Saved" << m_rowCount << "project(s) to" << snapshotPath;
+    return true;
+}
+
+QString ProjectStore::text(Field field, int row) const {
+    const StringRef &ref = m_strings[field][row];
+    return QString(m_text + ref.offset, qsizetype(ref.length));
+}
+
+ProjectRecord ProjectStore::record(int row) const {
+    ProjectRecord record;
+    record.path = path(row);
+    record.name = name(row);
+    record.uid = uid(row);
+    record.type = type(row);
+    record.timestamp = timestamp(row);
+    record.visitCount = visitCount(row);
+    return record;
+}
+
+ProjectLists ProjectStore::lists(ProjectListParser::Sections sections) const {
+    // Sections and lists share their order: RecentSection is 1 << RecentList.
+    ProjectLists lists;
+    ProjectRecordList *targets[LIST_COUNT] = { &lists.recent, &lists.pinned, &lists.visited, &lists.projects };
+    for (int list = 0; list < LIST_COUNT; ++list) {
+        if (!sections.testFlag(ProjectListParser::Section(1 << list))) continue;
+        targets[list]->reserve(listSize(List(list)));
+        for (int position = 0; position < listSize(List(list)); ++position) {
+            targets[list]->append(record(listRow(List(list), position)));
+        }
+    }
+    return lists;
+}
+
+int ProjectStore::find(const qint32 *index, Field field, const QString &key) const {
+    if (key.isEmpty() || m_indexCapacity == 0) return -1;
+    const quint32 mask = m_indexCapacity - 1;
+    quint32 slot = quint32(fnv1a(key.constData(), key.size())) & mask;
+    for (quint32 probe = 0; probe < m_indexCapacity; ++probe, slot = (slot + 1) & mask) {
+        const qint32 row = index[slot];
+        if (row < 0) return -1;
+        const StringRef &ref = m_strings[field][row];
+        if (ref.length == quint32(key.size()) && std::memcmp(m_text + ref.offset, key.constData(), size_t(ref.length) * sizeof(QChar)) == 0) {
+            return row;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,132 @@
+#ifndef PROJECTSTORE_H
+#define PROJECTSTORE_H
+
+#include "projectlistparser.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QFuture>
+#include <QSharedPointer>
+#include <QString>
+
+class ProjectStore;
+using ProjectStorePtr = QSharedPointer<const ProjectStore>;
+
+// Read-only, typed view of projects.json. Every distinct path is one row;
+// names, paths, UIDs, types, timestamps, visit counts and list membership
+// are stored column by column, and the recent/pinned/visited/projects lists
+// keep their own order as arrays of rows. Paths and UIDs have FNV-1a hash
+// indexes. The whole store is one flat block in the snapshot layout, so it
+// is either built in memory from parsed lists or mapped as is from
+// projects.snapshot next to projects.json. projects.json stays the file
+// other tools read and write; a snapshot whose recorded size or modification
+// time no longer matches it is ignored and rebuilt. The snapshot also records
+// how much of projects.journal it already includes, so only records appended
+// after it was saved are replayed over it.
+class ProjectStore {
+public:
+    enum Flag {
+        InRecent = 0x1,
+        InPinned = 0x2,
+        InVisited = 0x4,
+        InProjects = 0x8
+    };
+    Q_DECLARE_FLAGS(Flags, Flag)
+
+    enum List { RecentList, PinnedList, VisitedList, ProjectsList, LIST_COUNT };
+
+    // What a store was built from; a snapshot is only used while it matches.
+    struct Stamp {
+        qint64 sourceSize = 0;
+        qint64 sourceModifiedMs = 0;
+        qint64 journalBytes = 0;    // Leading bytes of projects.journal already applied
+    };
+
+    // allProjects: for a store built without the projects section, the
+    // pending build of the complete store.
+    static ProjectStorePtr build(const ProjectLists &lists, const Stamp &stamp = Stamp(),
+                                 const QFuture<ProjectStorePtr> &allProjects = QFuture<ProjectStorePtr>());
+    static ProjectStorePtr open(const QString &snapshotPath, const QString &sourcePath); // Null when missing, stale or damaged
+    static QString snapshotPathFor(const QString &sourcePath);
+    bool save(const QString &snapshotPath) const; // Complete stores only; takes effect at the next open()
+
+    int count() const { return m_rowCount; }
+    QString name(int row) const { return text(NameField, row); }
+    QString path(int row) const { return text(PathField, row); }
+    QString uid(int row) const { return text(UidField, row); }
+    QString type(int row) const { return text(TypeField, row); }
+    double timestamp(int row) const { return m_timestamps[row]; }
+    int visitCount(int row) const { return m_visitCounts[row]; }
+    Flags flags(int row) const { return Flags(QFlag(int(m_flags[row]))); }
+    ProjectRecord record(int row) const;
+    // Back to parsed form, e.g. to apply journaled changes. Lists outside sections stay empty.
+    ProjectLists lists(ProjectListParser::Sections sections = ProjectListParser::FirstPaintSections | ProjectListParser::ProjectsSection) const;
+    Stamp stamp() const { return m_stamp; }
+
+    int listSize(List list) const { return int(m_listCounts[list]); }
+    int listRow(List list, int position) const { return m_lists[list][position]; }
+
+    int findPath(const QString &path) const { return find(m_pathIndex, PathField, path); } // -1 if absent
+    int findUid(const QString &uid) const { return find(m_uidIndex, UidField, uid); }
+
+    bool hasAllProjects() const { return m_hasAllProjects; }
+    QFuture<ProjectStorePtr> allProjects() const { return m_allProjects; } // Only while !hasAllProjects()
+    bool isMapped() const { return !m_file.isNull(); }
+
+    static const quint32 FORMAT_VERSION = 2;
+
+private:
+    enum Field { NameField, PathField, UidField, TypeField, FIELD_COUNT };
+
+    struct StringRef {
+        quint32 offset;             // In UTF-16 units from the start of the text block
+        quint32 length;
+    };
+
+    struct Layout {
+        qint64 strings[FIELD_COUNT];
+        qint64 timestamps;
+        qint64 visitCounts;
+        qint64 flags;
+        qint64 lists[LIST_COUNT];
+        qint64 pathIndex;
+        qint64 uidIndex;
+        qint64 text;
+        qint64 total;
+    };
+
+    ProjectStore();
+    Q_DISABLE_COPY(ProjectStore)
+    static Layout layoutFor(quint32 rowCount, const quint32 *listCounts, quint32 indexCapacity, quint64 textUnits);
+    bool attach(const uchar *data, qint64 size);
+    bool validate() const;
+    QString text(Field field, int row) const;
+    int find(const qint32 *index, Field field, const QString &key) const;
+
+    QByteArray m_buffer;            // Owns the block of a built store
+    QSharedPointer<QFile> m_file;   // Or keeps the mapping of an opened one
+    const uchar *m_data;
+    qint64 m_size;
+
+    int m_rowCount;
+    const StringRef *m_strings[FIELD_COUNT];
+    const double *m_timestamps;
+    const qint32 *m_visitCounts;
+    const quint32 *m_flags;
+    const qint32 *m_lists[LIST_COUNT];
+    quint32 m_listCounts[LIST_COUNT];
+    const qint32 *m_pathIndex;
+    const qint32 *m_uidIndex;
+    quint32 m_indexCapacity;        // Power of two, at least twice the row count
+    const QChar *m_text;
+    quint64 m_textUnits;
+    Stamp m_stamp;
+
+    bool m_hasAllProjects;
+    QFuture<ProjectStorePtr> m_allProjects;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(ProjectStore::Flags)
+Q_DECLARE_METATYPE(ProjectStorePtr)
+
+#endif // PROJECTSTORE_H
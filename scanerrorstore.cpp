@@ -0,0 +1,102 @@
+#include "scanerrorstore.h"
+
+ScanErrorStore::ScanErrorStore()
+    : m_totalCount(0)
+{
+}
+
+QString ScanErrorStore::groupPrefixFor(const QString &path) {
+    auto isSeparator = [](QChar c) { return c == QLatin1Char('/') || c == QLatin1Char('\\'); };
+
+    int end = path.size();
+    while (end > 1 && isSeparator(path.at(end - 1))) --end; // Ignore trailing separators
+    int lastSeparator = end - 1;
+    while (lastSeparator >= 0 && !isSeparator(path.at(lastSeparator))) --lastSeparator;
+    if (lastSeparator < 0) return QString();
+    if (lastSeparator == 0) return path.left(1); // Parent is the root
+
+    // Keep the parent directory, cut after GROUP_PREFIX_DEPTH components.
+    int components = 0;
+    for (int i = 0; i < lastSeparator; ++i) {
+        if (isSeparator(path.at(i))) continue;
+        if (i == 0 || isSeparator(path.at(i - 1))) {
+            if (++components > GROUP_PREFIX_DEPTH) return path.left(i - 1);
+        }
+    }
+    return path.left(lastSeparator);
+}
+
+int ScanErrorStore::internReason(const QString &reason) {
+    auto it = m_reasonIds.constFind(reason);
+    if (it != m_reasonIds.constEnd()) return it.value();
+    const int id = m_reasons.size();
+    m_reasons.append(reason);
+    m_reasonIds.insert(reason, id);
+    return id;
+}
+
+int ScanErrorStore::groupIndexFor(int reasonId, PathId prefixId, PathId firstPathId) {
+    auto it = m_groupIndex.constFind(qMakePair(reasonId, prefixId));
+    if (it != m_groupIndex.constEnd()) return it.value();
+
+    if (m_groups.size() >= MAX_GROUPS) return overflowGroupIndexFor(reasonId, firstPathId);
+
+    Group group;
+    group.reasonId = reasonId;
+    group.prefixId = prefixId;
+    group.firstPathId = firstPathId;
+    m_groups.append(group);
+    m_groupIndex.insert(qMakePair(reasonId, prefixId), m_groups.size() - 1);
+    return m_groups.size() - 1;
+}
+
+int ScanErrorStore::overflowGroupIndexFor(int reasonId, PathId firstPathId) {
+    auto it = m_overflowGroupIndex.constFind(reasonId);
+    if (it != m_overflowGroupIndex.constEnd()) return it.value();
+
+    // Overflow groups are the only ones allowed past the cap (at most one per reason).
+    Group group;
+    group.reasonId = reasonId;
+    group.firstPathId = firstPathId;
+    group.isOverflow = true;
+    m_groups.append(group);
+    m_overflowGroupIndex.insert(reasonId, m_groups.size() - 1);
+    return m_groups.size() - 1;
+}
+
+bool ScanErrorStore::add(const QString &path, const QString &reason) {
+    PathTree &tree = PathTree::shared();
+    const int reasonId = internReason(reason);
+    const QString prefix = groupPrefixFor(path);
+
+    // Look the group up without interning; a path is only added to the tree
+    // when this store is going to keep it.
+    const PathId knownPrefixId = tree.find(prefix);
+    int groupIndex = knownPrefixId ? m_groupIndex.value(qMakePair(reasonId, knownPrefixId), -1) : -1;
+    if (groupIndex < 0) {
+        const auto overflowIt = m_overflowGroupIndex.constFind(reasonId);
+        if (m_groups.size() >= MAX_GROUPS && overflowIt != m_overflowGroupIndex.constEnd()) {
+            groupIndex = overflowIt.value();
+        } else if (m_groups.size() >= MAX_GROUPS) {
+            groupIndex = overflowGroupIndexFor(reasonId, tree.intern(path));
+        } else {
+            groupIndex = groupIndexFor(reasonId, tree.intern(prefix), tree.intern(path));
+        }
+    }
+    m_groups[groupIndex].count++;
+    ++m_totalCount;
+
+    if (m_samples.size() >= MAX_SAMPLE_ENTRIES) return false;
+    m_samples.append({tree.intern(path), reasonId});
+    return true;
+}
+
+void ScanErrorStore::clear() {
+    m_reasons.clear();
+    m_reasonIds.clear();
+    m_groups.clear();
+    m_groupIndex.clear();
+    m_overflowGroupIndex.clear();
+    m_samples.clear();
+    m_totalCount = 0;
+}
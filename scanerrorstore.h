@@ -0,0 +1,80 @@
+#ifndef SCANERRORSTORE_H
+#define SCANERRORSTORE_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QPair>
+#include <QHash>
+#include <QMetaType>
+#include "pathtree.h"
+
+// One issue as reported, before any store decides what to keep of it.
+// Batches of these cross threads, so reporting an error interns nothing.
+struct ScanError {
+    QString path;
+    QString reason;
+};
+
+// Bounded, aggregated record of scan issues.
+// Reasons are interned, and every error is counted in a group keyed by
+// (reason, leading directories of the parent path). Only the first
+// MAX_SAMPLE_ENTRIES errors keep their full path; once MAX_GROUPS groups exist,
+// further locations fold into one "other locations" group per reason. Memory
+// therefore stays constant however many errors a scan produces.
+// Paths are kept as PathTree ids, and only retained paths (group prefixes,
+// group examples, samples) are ever interned, so the shared tree stays bounded
+// too. A plain value type (implicitly shared members): cheap to copy across
+// threads.
+class ScanErrorStore {
+public:
+    struct Group {
+        int reasonId = -1;
+        PathId prefixId = 0;
+        PathId firstPathId = 0; // First path that landed in this group
+        qint64 count = 0;
+        bool isOverflow = false; // Per-reason "other locations" group past MAX_GROUPS
+    };
+
+    struct Sample {
+        PathId pathId = 0;
+        int reasonId = -1;
+    };
+
+    ScanErrorStore();
+
+    // Returns true when the entry was also kept as a full sample.
+    bool add(const QString &path, const QString &reason);
+    void clear();
+
+    bool isEmpty() const { return m_totalCount == 0; }
+    qint64 totalCount() const { return m_totalCount; }
+    int groupCount() const { return m_groups.size(); }
+    const Group &groupAt(int index) const { return m_groups.at(index); }
+    QString reason(int reasonId) const { return m_reasons.value(reasonId); }
+    const QList<Sample> &samples() const { return m_samples; }
+
+    static QString groupPrefixFor(const QString &path);
+
+    static const int MAX_GROUPS = 5000;
+    static const int MAX_SAMPLE_ENTRIES = 2000;
+    static const int GROUP_PREFIX_DEPTH = 3; // Directory components kept in a group prefix
+
+private:
+    int internReason(const QString &reason);
+    int groupIndexFor(int reasonId, PathId prefixId, PathId firstPathId);
+    int overflowGroupIndexFor(int reasonId, PathId firstPathId);
+
+    QStringList m_reasons;
+    QHash<QString, int> m_reasonIds;
+    QList<Group> m_groups;
+    QHash<QPair<int, PathId>, int> m_groupIndex;
+    QHash<int, int> m_overflowGroupIndex; // reasonId -> group
+    QList<Sample> m_samples;
+    qint64 m_totalCount;
+};
+
+Q_DECLARE_METATYPE(ScanError)
+Q_DECLARE_METATYPE(ScanErrorStore)
+
+#endif // SCANERRORSTORE_H
@@ -0,0 +1,242 @@
+#include "scanlogexporter.h"
+
+#include <QSaveFile>
+#include <QDateTime>
+#include <QDebug>
+#include <array>
+
+namespace {
+quint32 crc32(const QByteArray &data) {
+    static const auto table = []() {
+        std::array<quint32, 256> t{};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    quint32 crc = 0xFFFFFFFFu;
+    for (const char byte : data) crc = table[(crc ^ static_cast<quint8>(byte)) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void appendLittleEndian32(QByteArray &out, quint32 value) {
+    for (int i = 0; i < 4; ++i) out.append(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+// Wraps one chunk as a complete gzip member; gzip readers decode concatenated members as one stream.
+QByteArray gzipMember(const QByteArray &data) {
+    // qCompress output: 4-byte length prefix, 2-byte zlib header, raw deflate data, 4-byte Adler-32.
+    const QByteArray zlib = qCompress(data, 6);
+    if (zlib.size() < 10) return QByteArray();
+
+    static const char header[10] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff'};
+    QByteArray member;
+    member.reserve(zlib.size() + 8);
+    member.append(header, sizeof(header));
+    member.append(zlib.constData() + 6, zlib.size() - 10);
+    appendLittleEndian32(member, crc32(data));
+    appendLittleEndian32(member, static_cast<quint32>(data.size()));
+    return member;
+}
+
+void appendJsonString(QByteArray &out, const QString &value) {
+    static const char hex[] = "0123456789abcdef";
+    out.append('"');
+    const QByteArray utf8 = value.toUtf8();
+    for (const char ch : utf8) {
+        const quint8 byte = static_cast<quint8>(ch);
+        if (ch == '"' || ch == '\\') {
+            out.append('\\').append(ch);
+        } else if (ch == '\n') {
+            out.append("\\n");
+        } else if (ch == '\r') {
+            out.append("\\r");
+        } else if (ch == '\t') {
+            out.append("\\t");
+        } else if (byte < 0x20) {
+            out.append("\\u00").append(hex[byte >> 4]).append(hex[byte & 0xF]);
+        } else {
+            out.append(ch);
+        }
+    }
+    out.append('"');
+}
+
+void appendCsvField(QByteArray &out, const QString &value) {
+    const QByteArray utf8 = value.toUtf8();
+    if (!utf8.contains(',') && !utf8.contains('"') && !utf8.contains('\n') && !utf8.contains('\r')) {
+        out.append(utf8);
+        return;
+    }
+    out.append('"');
+    for (const char ch : utf8) {
+        if (ch == '"') out.append('"');
+        out.append(ch);
+    }
+    out.append('"');
+}
+}
+
+ScanLogExporter::ScanLogExporter(QObject *parent)
+    : QObject(parent),
+      m_cancelRequested(false)
+{
+}
+
+QString ScanLogExporter::fileDialogFilters() {
+    return "Text Files (*.txt);;JSON Lines (*.jsonl);;CSV Files (*.csv);;"
+           "Compressed Text (*.txt.gz);;Compressed JSON Lines (*.jsonl.gz);;Compressed CSV (*.csv.gz);;"
+           "All Files (*)";
+}
+
+ScanLogExporter::Format ScanLogExporter::formatForFileName(const QString &fileName, bool *gzip) {
+    QString name = fileName.toLower();
+    const bool compressed = name.endsWith(".gz");
+    if (compressed) name.chop(3);
+    if (gzip) *gzip = compressed;
+    if (name.endsWith(".jsonl") || name.endsWith(".ndjson")) return JsonLines;
+    if (name.endsWith(".csv")) return Csv;
+    return Text;
+}
+
+void ScanLogExporter::cancel() {
+    m_cancelRequested = true;
+}
+
+void ScanLogExporter::exportLog(const QString &fileName, ScanLogExporter::Format format, bool gzip,
+                                const ScanErrorStore &errors) {
+    m_cancelRequested = false;
+    const QList<ScanErrorStore::Sample> &samples = errors.samples();
+    const PathTree &paths = PathTree::shared();
+    const qint64 total = samples.size() + errors.groupCount();
+    qDebug() << "ScanLogExporter: Exporting" << samples.size() << "entries and" << errors.groupCount()
+             << "group(s) to" << fileName << "format:" << format << "gzip:" << gzip;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        emit exportFinished(false, false, fileName, file.errorString());
+        return;
+    }
+
+    QByteArray buffer;
+    buffer.reserve(WRITE_CHUNK_BYTES + 4096);
+    bool writeFailed = false;
+    auto flushBuffer = [&]() {
+        if (buffer.isEmpty() || writeFailed) return;
+        if (gzip) {
+            const QByteArray member = gzipMember(buffer);
+            if (file.write(member) != member.size()) writeFailed = true;
+        } else if (file.write(buffer) != buffer.size()) {
+            writeFailed = true;
+        }
+        buffer.resize(0); // Unlike clear(), keeps the allocation for the next chunk
+    };
+
+    switch (format) {
+    case Text:
+        buffer.append("SOFTUDIO Project Scan Log - ").append(QDateTime::currentDateTime().toString(Qt::ISODate).toUtf8()).append('\n');
+        buffer.append("-----------------------------------------------------------------------\n\n");
+        if (errors.isEmpty()) buffer.append("No issues reported during the scan.\n");
+        break;
+    case Csv:
+        buffer.append("kind,path,reason,count\n");
+        break;
+    case JsonLines:
+        break;
+    }
+
+    qint64 written = 0;
+    for (qint64 record = 0; record < total; ++record) {
+        const bool isSample = record < samples.size();
+        if (isSample) {
+            const ScanErrorStore::Sample &sample = samples.at(record);
+            const QString path = paths.path(sample.pathId);
+            const QString reason = errors.reason(sample.reasonId);
+            switch (format) {
+            case Text:
+                buffer.append("Path: ").append(path.toUtf8()).append('\n');
+                buffer.append("Reason: ").append(reason.toUtf8()).append("\n\n");
+                break;
+            case JsonLines:
+                buffer.append("{\"path\":");
+                appendJsonString(buffer, path);
+                buffer.append(",\"reason\":");
+                appendJsonString(buffer, reason);
+                buffer.append("}\n");
+                break;
+            case Csv:
+                buffer.append("entry,");
+                appendCsvField(buffer, path);
+                buffer.append(',');
+                appendCsvField(buffer, reason);
+                buffer.append(",1\n");
+                break;
+            }
+        } else {
+            const int groupIndex = static_cast<int>(record - samples.size());
+            const ScanErrorStore::Group &group = errors.groupAt(groupIndex);
+            const QString reason = errors.reason(group.reasonId);
+            const QString location = group.isOverflow ? QString() : paths.path(group.prefixId);
+            const QByteArray count = QByteArray::number(group.count);
+            switch (format) {
+            case Text:
+                if (groupIndex == 0) {
+                    if (errors.totalCount() > samples.size()) {
+                        buffer.append(QByteArray::number(errors.totalCount() - samples.size())).append(" more issue(s) are only counted below.\n\n");
+                    }
+                    buffer.append("Issues by location\n");
+                    buffer.append("-----------------------------------------------------------------------\n");
+                }
+                buffer.append(count).append(" x ").append(reason.toUtf8()).append(" in ");
+                buffer.append(group.isOverflow ? QByteArray("(other locations)") : location.toUtf8()).append('\n');
+                break;
+            case JsonLines:
+                buffer.append("{\"location\":");
+                if (group.isOverflow) buffer.append("null");
+                else appendJsonString(buffer, location);
+                buffer.append(",\"reason\":");
+                appendJsonString(buffer, reason);
+                buffer.append(",\"count\":").append(count).append(",\"example\":");
+                appendJsonString(buffer, paths.path(group.firstPathId));
+                buffer.append("}\n");
+                break;
+            case Csv:
+                buffer.append("group,");
+                if (!group.isOverflow) appendCsvField(buffer, location);
+                buffer.append(',');
+                appendCsvField(buffer, reason);
+                buffer.append(',').append(count).append('\n');
+                break;
+            }
+        }
+
+        if (buffer.size() >= WRITE_CHUNK_BYTES) flushBuffer();
+        if (++written % PROGRESS_EVERY_RECORDS == 0) {
+            if (m_cancelRequested || writeFailed) break;
+            emit progress(written, total);
+        }
+    }
+
+    if (format == Text && !m_cancelRequested) {
+        if (!errors.isEmpty()) buffer.append("\n");
+        buffer.append("-----------------------------------------------------------------------\n");
+        buffer.append("Scan process finished.\n");
+    }
+    if (!m_cancelRequested) flushBuffer();
+
+    if (m_cancelRequested) {
+        file.cancelWriting();
+        qDebug() << "ScanLogExporter: Export canceled after" << written << "record(s).";
+        emit exportFinished(false, true, fileName, QString());
+        return;
+    }
+    if (writeFailed || !file.commit()) {
+        qWarning() << "ScanLogExporter: Export to" << fileName << "failed:" << file.errorString();
+        emit exportFinished(false, false, fileName, file.errorString());
+        return;
+    }
+    emit progress(total, total);
+    emit exportFinished(true, false, fileName, QString());
+}
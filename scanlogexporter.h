@@ -0,0 +1,48 @@
+#ifndef SCANLOGEXPORTER_H
+#define SCANLOGEXPORTER_H
+
+#include <QObject>
+#include <QString>
+#include "scanerrorstore.h"
+#include <atomic>
+
+// Writes the scan log to disk on a worker thread: the sampled issues in full,
+// then one summary record per (location, reason) group.
+// Records are formatted straight into a small write buffer (optionally gzip
+// compressed chunk by chunk), so the log is never held twice in memory.
+// Output goes through QSaveFile: a failed or canceled export leaves any
+// existing file untouched.
+class ScanLogExporter : public QObject {
+    Q_OBJECT
+
+public:
+    enum Format {
+        Text,
+        JsonLines,
+        Csv
+    };
+    Q_ENUM(Format)
+
+    explicit ScanLogExporter(QObject *parent = nullptr);
+
+    // File dialog filters, and the format/compression they imply for a chosen file name.
+    static QString fileDialogFilters();
+    static Format formatForFileName(const QString &fileName, bool *gzip);
+
+public slots:
+    void exportLog(const QString &fileName, ScanLogExporter::Format format, bool gzip,
+                   const ScanErrorStore &errors);
+    void cancel(); // Thread-safe; call through a direct connection
+
+signals:
+    void progress(qint64 recordsWritten, qint64 recordsTotal);
+    void exportFinished(bool success, bool canceled, const QString &fileName, const QString &errorMessage);
+
+private:
+    std::atomic<bool> m_cancelRequested;
+
+    const int WRITE_CHUNK_BYTES = 1 << 20;      // Uncompressed bytes per write / gzip member
+    const int PROGRESS_EVERY_RECORDS = 4096;
+};
+
+#endif // SCANLOGEXPORTER_H
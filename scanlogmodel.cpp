@@ -0,0 +1,72 @@
+#include "scanlogmodel.h"
+
+#include <QDir>
+
+ScanLogModel::ScanLogModel(QObject *parent)
+    : QAbstractTableModel(parent),
+      m_rowCount(0)
+{
+}
+
+int ScanLogModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+int ScanLogModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ScanLogModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_rowCount) return QVariant();
+
+    const ScanErrorStore::Group &group = m_store.groupAt(index.row());
+    const PathTree &paths = PathTree::shared(); // Strings are only built for painted cells
+    if (role == Qt::TextAlignmentRole && index.column() == CountColumn) {
+        return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    if (role == Qt::ToolTipRole && index.column() == PathColumn && group.count > 1) {
+        return QString("%L1 issues, e.g. %2").arg(group.count).arg(paths.path(group.firstPathId));
+    }
+    if (role != Qt::DisplayRole && role != Qt::ToolTipRole) return QVariant();
+
+    switch (index.column()) {
+    case PathColumn:
+        if (group.count == 1) return paths.path(group.firstPathId);
+        if (group.isOverflow) return QStringLiteral("(other locations)");
+        return paths.path(group.prefixId) + QDir::separator() + QStringLiteral("...");
+    case ReasonColumn: return m_store.reason(group.reasonId);
+    case CountColumn:  return QString("%L1").arg(group.count);
+    default:           return QVariant();
+    }
+}
+
+QVariant ScanLogModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+    case PathColumn:   return QStringLiteral("Path");
+    case ReasonColumn: return QStringLiteral("Reason");
+    case CountColumn:  return QStringLiteral("Count");
+    default:           return QVariant();
+    }
+}
+
+void ScanLogModel::addErrors(const QList<ScanError> &errors) {
+    if (errors.isEmpty()) return;
+    for (const ScanError &error : errors) m_store.add(error.path, error.reason);
+
+    // Existing rows may have new counts (and a single path may have become a group).
+    if (m_rowCount > 0) emit dataChanged(index(0, 0), index(m_rowCount - 1, ColumnCount - 1));
+    if (m_store.groupCount() > m_rowCount) {
+        beginInsertRows(QModelIndex(), m_rowCount, m_store.groupCount() - 1);
+        m_rowCount = m_store.groupCount();
+        endInsertRows();
+    }
+}
+
+void ScanLogModel::clear() {
+    if (m_store.isEmpty() && m_rowCount == 0) return;
+    beginResetModel();
+    m_store.clear();
+    m_rowCount = 0;
+    endResetModel();
+}
@@ -0,0 +1,38 @@
+#ifndef SCANLOGMODEL_H
+#define SCANLOGMODEL_H
+
+#include <QAbstractTableModel>
+#include "scanerrorstore.h"
+
+// Table model over the aggregated scan issues: one row per (location, reason) group.
+// Fed in batches while the scan runs; new groups arrive as row inserts and
+// existing groups only change their count.
+class ScanLogModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        PathColumn = 0,
+        ReasonColumn = 1,
+        CountColumn = 2,
+        ColumnCount = 3
+    };
+
+    explicit ScanLogModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    void addErrors(const QList<ScanError> &errors);
+    void clear();
+    const ScanErrorStore &errorStore() const { return m_store; }
+    qint64 totalErrorCount() const { return m_store.totalCount(); }
+
+private:
+    ScanErrorStore m_store;
+    int m_rowCount; // Groups the views know about; the store may briefly hold more while merging
+};
+
+#endif // SCANLOGMODEL_H
@@ -1,6 +1,14 @@
 #include "scannerdialog.h"
 #include "scanworker.h"
 #include "projectfilevalidatorworker.h" // Make sure this is correctly included
+#include "scanresultsmodel.h"
+#include "scanlogmodel.h"
+#include "drivediscovery.h"
+#include "animationframecache.h"
+#include "scanlogexporter.h"
+#include "traversalfrontier.h"
+#include "traversalstatistics.h"
+#include "projectjournal.h"
 
 #include <QCloseEvent>
 #include <QShowEvent>
@@ -16,6 +24,10 @@
 #include <QDir>
 #include <QListWidget>
 #include <QTableWidget>
+#include <QTableView>
+#include <QTabWidget>
+#include <QScreen>
+#include <QFontMetrics>
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QGroupBox>
@@ -25,17 +37,13 @@
 #include <QDialogButtonBox>
 #include <QCoreApplication>
 #include <QTimer>
-#include <QMovie>
 #include <QDebug>
 #include <QElapsedTimer>
 #include <QDesktopServices>
 #include <QUrl>
-#include <QStorageInfo>
-#include <QProcess>     // For Linux /proc/mounts parsing if needed (alternative to QFile)
-
-#ifdef Q_OS_WIN
-#include <windows.h>
-#endif
+#include <QProgressDialog>
+#include <QRegularExpression>
+#include <QSpinBox>
 
 ScannerDialog::ScannerDialog(QWidget *parent)
     : FramelessDialogBase(parent),
@@ -45,6 +53,9 @@ ScannerDialog::ScannerDialog(QWidget *parent)
       m_configPage(nullptr),
       m_quickScanRadio(nullptr),
       m_deepScanRadio(nullptr),
+      m_budgetedScanRadio(nullptr),
+      m_scanBudgetSpinBox(nullptr),
+      m_backgroundScanCheckBox(nullptr),
       m_fullDiskRadio(nullptr),
       m_selectDrivesRadio(nullptr),
       m_selectFolderRadio(nullptr),
@@ -53,6 +64,7 @@ ScannerDialog::ScannerDialog(QWidget *parent)
       m_browseFolderButton(nullptr),
       m_folderSelectWidget(nullptr),
       m_drivesListContainerWidget(nullptr),
+      m_driveDiscovery(nullptr),
       m_progressPage(nullptr),
       m_progressStatusLabel(nullptr),
       m_progressCurrentPathLabel(nullptr),
@@ -60,20 +72,38 @@ ScannerDialog::ScannerDialog(QWidget *parent)
       m_progressTimeEtcLabel(nullptr),
       m_progressAnimationLabel(nullptr),
       m_progressCancelButton(nullptr),
+      m_progressLiveTabs(nullptr),
+      m_progressResultsView(nullptr),
+      m_progressLogView(nullptr),
+      m_progressImportButton(nullptr),
+      m_progressSnapshotDirty(false),
+      m_progressRenderTimer(nullptr),
+      m_activeScanBudgetSec(0),
+      m_activeBackgroundScan(false),
+      m_progressAnimationTimer(nullptr),
+      m_progressAnimationFrame(-1),
+      m_elidedPathWidth(-1),
+      m_lastRenderedElapsedSec(-1),
       m_logPage(nullptr),
-      m_logTableWidget(nullptr),
+      m_logTableView(nullptr),
+      m_logModel(nullptr),
       m_exportLogButton(nullptr),
+      m_logExporter(nullptr),
+      m_logExportProgress(nullptr),
       m_resultsPage(nullptr),
-      m_resultsTableWidget(nullptr),
+      m_resultsTableView(nullptr),
+      m_resultsModel(nullptr),
       m_resultsSelectAllButton(nullptr),
       m_resultsDeselectAllButton(nullptr),
       m_resultsButtonBox(nullptr),
       m_settings(nullptr),
       m_scanWorker(nullptr),
       m_validatorWorker(nullptr),
+      m_liveUpdateTimer(nullptr),
       m_scanInProgress(false),
       m_scanCancelled(false),
-      m_scanStartTime(0)
+      m_scanStartTime(0),
+      m_loadingSettings(false)
 {
     setWindowTitle("Project Scanner");
     // It's good practice to set a unique object name for top-level dialogs for styling/testing
@@ -81,8 +111,23 @@ ScannerDialog::ScannerDialog(QWidget *parent)
 
     m_settings = new QSettings(QSettings::IniFormat, QSettings::UserScope, "SOFTUDIO", "ProjectScanner", this);
 
+    m_resultsModel = new ScanResultsModel(this);
+    connect(m_resultsModel, &ScanResultsModel::checkedCountChanged, this, &ScannerDialog::onResultsSelectionChanged);
+    m_logModel = new ScanLogModel(this);
+
+    m_liveUpdateTimer = new QTimer(this);
+    m_liveUpdateTimer->setInterval(LIVE_UPDATE_INTERVAL_MS);
+    connect(m_liveUpdateTimer, &QTimer::timeout, this, &ScannerDialog::flushLiveUpdates);
+
+    m_progressRenderTimer = new QTimer(this);
+    m_progressRenderTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_progressRenderTimer, &QTimer::timeout, this, &ScannerDialog::renderScanProgress);
+
+    m_progressAnimationTimer = new QTimer(this);
+    m_progressAnimationTimer->setSingleShot(true); // Rearmed per frame with that frame's delay
+    connect(m_progressAnimationTimer, &QTimer::timeout, this, &ScannerDialog::advanceProgressAnimation);
+
     setupUi();
-    loadSettings();
 
     // Connections for thread cleanup
     connect(&m_scanWorkerThread, &QThread::finished, this, [this]() {
@@ -105,6 +150,11 @@ ScannerDialog::~ScannerDialog()
 {
     qDebug() << "ScannerDialog: Destructor called.";
     stopScanThreadsAndCleanup(); // Ensure threads are stopped before dialog is destroyed
+    if (m_logExportThread.isRunning()) {
+        if (m_logExporter) m_logExporter->cancel(); // Discards a partially written export
+        m_logExportThread.quit();
+        m_logExportThread.wait();
+    }
     // m_settings is a child, will be deleted by QObject parent.
 }
 
@@ -119,29 +169,14 @@ void ScannerDialog::setupUi() {
     mainLayout->setSpacing(0);                 // No spacing for the stacked widget container
 
     m_stackedWidget = new QStackedWidget(this);
-
-    setupInitialPromptPage();
-    setupConfigPage();
-    setupProgressPage();
-    setupLogPage();
-    setupResultsPage();
-
     mainLayout->addWidget(m_stackedWidget);
     // setLayout(mainLayout); // Already set by FramelessDialogBase if it calls setLayout in its constructor
 
-    QTimer::singleShot(0, this, [this]() {
-        bool dontShow = m_settings->value(SETTING_DONT_SHOW_PROMPT_V2, false).toBool();
-        bool isStandalone = QCoreApplication::instance()->property("is_standalone_runner").toBool();
-
-        if (isStandalone) {
-            showPage(dontShow ? Configuration : InitialPrompt);
-        } else { // Integrated mode
-            showPage(dontShow ? Configuration : InitialPrompt);
-            // If integrated and "don't show" is true, the parent application
-            // might decide not to even 'exec' this dialog, or call a specific method
-            // to directly start the configuration or scan.
-        }
-    });
+    // Pages are built by showPage() on first use; most sessions only ever see the prompt.
+    // In integrated mode with "don't show" set, the parent application might decide not
+    // to even 'exec' this dialog, or call a specific method to start the configuration or scan.
+    bool dontShow = m_settings->value(SETTING_DONT_SHOW_PROMPT_V2, false).toBool();
+    showPage(dontShow ? Configuration : InitialPrompt);
 }
 
 void ScannerDialog::setupInitialPromptPage() {
@@ -229,8 +264,26 @@ void ScannerDialog::setupConfigPage() {
     m_deepScanRadio = new QRadioButton(SCAN_TYPE_DEEP, scanTypeGroup);
     m_quickScanRadio->setToolTip("Scans only the top few levels of folders. Faster.");
     m_deepScanRadio->setToolTip("Scans every subfolder. Slower but more thorough.");
+    m_budgetedScanRadio = new QRadioButton(SCAN_TYPE_BUDGETED, scanTypeGroup);
+    m_budgetedScanRadio->setToolTip("Visits home, documents and workspace folders first, then shallow folders before deep ones.\n"
+                                    "Stops when the time budget is used up.");
+    m_scanBudgetSpinBox = new QSpinBox(scanTypeGroup);
+    m_scanBudgetSpinBox->setRange(5, 3600);
+    m_scanBudgetSpinBox->setSingleStep(15);
+    m_scanBudgetSpinBox->setSuffix(" s");
+    m_scanBudgetSpinBox->setPrefix("Time budget: ");
+    QHBoxLayout *budgetLayout = new QHBoxLayout();
+    budgetLayout->setContentsMargins(20, 0, 0, 0); // Indented under its radio button
+    budgetLayout->addWidget(m_scanBudgetSpinBox);
+    budgetLayout->addStretch(1);
+    m_backgroundScanCheckBox = new QCheckBox("Low-impact background scan", scanTypeGroup);
+    m_backgroundScanCheckBox->setToolTip("Runs the scan at idle disk and CPU priority and slows down while the disk or CPU is busy.\n"
+                                         "Takes longer, but keeps the computer responsive.");
     scanTypeLayout->addWidget(m_quickScanRadio);
     scanTypeLayout->addWidget(m_deepScanRadio);
+    scanTypeLayout->addWidget(m_budgetedScanRadio);
+    scanTypeLayout->addLayout(budgetLayout);
+    scanTypeLayout->addWidget(m_backgroundScanCheckBox);
     scanTypeGroup->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
 
     QGroupBox *scanScopeGroup = new QGroupBox("Scan Scope", m_configPage);
@@ -246,6 +299,7 @@ void ScannerDialog::setupConfigPage() {
     m_drivesListWidget->setMinimumHeight(80); // Set reasonable minimum instead of 0
     m_drivesListWidget->setMaximumHeight(120); // Limit maximum height
     m_drivesListWidget->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+    m_drivesListWidget->setSortingEnabled(true); // Locations arrive out of order from the discovery probes
     drivesListLayout->addWidget(m_drivesListWidget);
 
     m_selectFolderRadio = new QRadioButton(SCAN_SCOPE_FOLDER, scanScopeGroup);
@@ -274,6 +328,7 @@ void ScannerDialog::setupConfigPage() {
     connect(m_drivesListWidget, &QListWidget::itemChanged, this, &ScannerDialog::onDrivesListItemChanged);
     connect(m_quickScanRadio, &QRadioButton::toggled, this, &ScannerDialog::onScanTypeChanged);
     connect(m_deepScanRadio, &QRadioButton::toggled, this, &ScannerDialog::onScanTypeChanged);
+    connect(m_budgetedScanRadio, &QRadioButton::toggled, this, &ScannerDialog::onScanTypeChanged);
 
     QDialogButtonBox *configButtonBox = new QDialogButtonBox(QDialogButtonBox::Cancel, m_configPage);
     QPushButton* nextButton = configButtonBox->addButton("Next", QDialogButtonBox::AcceptRole);
@@ -294,6 +349,7 @@ void ScannerDialog::setupConfigPage() {
 
     m_stackedWidget->addWidget(m_configPage);
     populateDrivesList();
+    loadSettings();
 }
 
 void ScannerDialog::onConfigNextClicked() {
@@ -338,8 +394,8 @@ void ScannerDialog::onDrivesListItemChanged(QListWidgetItem* item) {
 
 void ScannerDialog::onScanTypeChanged()
 {
-    qDebug() << "ScannerDialog: Scan type changed to"
-             << (m_quickScanRadio->isChecked() ? "Quick" : "Deep");
+    qDebug() << "ScannerDialog: Scan type changed to" << getSelectedScanType();
+    m_scanBudgetSpinBox->setEnabled(m_budgetedScanRadio->isChecked());
     saveSettings(); // Update settings with the new scan type
 }
 
@@ -371,6 +427,46 @@ void ScannerDialog::setupProgressPage() {
     m_progressTimeEtcLabel = new QLabel("Elapsed: 00:00:00 | ETA: Calculating...", m_progressPage);
     m_progressTimeEtcLabel->setAlignment(Qt::AlignCenter);
 
+    // Live views share the results/log models, so hits can be reviewed (and imported) mid-scan.
+    m_progressLiveTabs = new QTabWidget(m_progressPage);
+    m_progressLiveTabs->setMinimumHeight(160);
+    m_progressResultsView = new QTableView(m_progressLiveTabs);
+    m_progressResultsView->setModel(m_resultsModel);
+    m_progressResultsView->horizontalHeader()->setSectionResizeMode(ScanResultsModel::CheckColumn, QHeaderView::Fixed);
+    m_progressResultsView->horizontalHeader()->setSectionResizeMode(ScanResultsModel::PathColumn, QHeaderView::Stretch);
+    m_progressResultsView->setColumnWidth(ScanResultsModel::CheckColumn, 35);
+    m_progressResultsView->setColumnWidth(ScanResultsModel::NameColumn, 160);
+    m_progressResultsView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_progressResultsView->verticalHeader()->setDefaultSectionSize(m_progressResultsView->fontMetrics().height() + 8);
+    m_progressResultsView->verticalHeader()->setVisible(false);
+    m_progressResultsView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_progressResultsView->setSelectionMode(QAbstractItemView::NoSelection);
+    m_progressResultsView->setWordWrap(false);
+
+    m_progressLogView = new QTableView(m_progressLiveTabs);
+    m_progressLogView->setModel(m_logModel);
+    m_progressLogView->horizontalHeader()->setSectionResizeMode(ScanLogModel::PathColumn, QHeaderView::Interactive);
+    m_progressLogView->horizontalHeader()->setSectionResizeMode(ScanLogModel::ReasonColumn, QHeaderView::Stretch);
+    m_progressLogView->horizontalHeader()->setSectionResizeMode(ScanLogModel::CountColumn, QHeaderView::ResizeToContents);
+    m_progressLogView->setColumnWidth(ScanLogModel::PathColumn, 300);
+    m_progressLogView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_progressLogView->verticalHeader()->setDefaultSectionSize(m_progressLogView->fontMetrics().height() + 8);
+    m_progressLogView->verticalHeader()->setVisible(false);
+    m_progressLogView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_progressLogView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_progressLogView->setWordWrap(false);
+
+    m_progressLiveTabs->addTab(m_progressResultsView, "Projects Found (0)");
+    m_progressLiveTabs->addTab(m_progressLogView, "Issues (0)");
+    m_progressLiveTabs->hide(); // Shown once the first hit or issue arrives
+
+    m_progressImportButton = new QPushButton("Import Selected", m_progressPage);
+    m_progressImportButton->setToolTip("Add the checked projects now, without waiting for the scan to finish.");
+    m_progressImportButton->setMinimumSize(100, 30);
+    m_progressImportButton->setEnabled(false);
+    m_progressImportButton->hide();
+    connect(m_progressImportButton, &QPushButton::clicked, this, &ScannerDialog::importSelectedDuringScan);
+
     QHBoxLayout* bottomBarLayout = new QHBoxLayout();
     bottomBarLayout->setContentsMargins(0, 0, 0, 0);
     bottomBarLayout->setSpacing(10);
@@ -380,6 +476,7 @@ void ScannerDialog::setupProgressPage() {
     m_progressAnimationLabel->setAlignment(Qt::AlignBottom | Qt::AlignLeft);
     bottomBarLayout->addWidget(m_progressAnimationLabel);
     bottomBarLayout->addStretch(); // Keep this stretch for button positioning
+    bottomBarLayout->addWidget(m_progressImportButton, 0, Qt::AlignBottom | Qt::AlignRight);
 
     m_progressCancelButton = new QPushButton("Cancel Scan", m_progressPage);
     m_progressCancelButton->setMinimumSize(100, 30);
@@ -395,30 +492,13 @@ void ScannerDialog::setupProgressPage() {
     layout->addWidget(m_progressBar);
     layout->addSpacing(10);
     layout->addWidget(m_progressTimeEtcLabel);
+    layout->addSpacing(10);
+    layout->addWidget(m_progressLiveTabs);
     layout->addSpacing(15);
     layout->addLayout(bottomBarLayout);
     layout->addSpacing(20);
 
-    QString animPathPrefix = QCoreApplication::applicationDirPath() + "/Engine/Graphics/Animation/STScan.anim/";
-    if (!QDir(animPathPrefix).exists()) {
-        animPathPrefix = ":/animations/STScan.anim/";
-        qWarning() << "Animation path" << QCoreApplication::applicationDirPath() + "/Engine/Graphics/Animation/STScan.anim/" << "not found. Attempting resource path" << animPathPrefix;
-    }
-
-    QStringList movieKeys = {"Initializing", "Scanning", "Finalizing", "Canceling", "Aborting"};
-    for(const QString& key : movieKeys) {
-        QString filePath = animPathPrefix + key + ".gif";
-        QMovie *movie = new QMovie(filePath, QByteArray(), this);
-        if(movie->isValid()){
-            movie->setCacheMode(QMovie::CacheAll);
-            movie->setSpeed(100);
-            m_progressMovies[key] = movie;
-            qDebug() << "ScannerDialog: Loaded animation" << key << "from" << filePath;
-        } else {
-            qWarning() << "ScannerDialog: Failed to load or invalid animation" << key << "from" << filePath << "Error:" << movie->lastErrorString();
-            delete movie;
-        }
-    }
+    // Animations are decoded on first use by setProgressAnimation(), at the label size.
 
     m_stackedWidget->addWidget(m_progressPage);
 }
@@ -438,20 +518,25 @@ void ScannerDialog::setupLogPage() {
     logTitle->setFont(logTitleFont);
     logTitle->setAlignment(Qt::AlignCenter);
 
-    QLabel *infoLabel = new QLabel("The scan encountered issues with the following paths:", m_logPage);
+    QLabel *infoLabel = new QLabel("The scan encountered issues with the following paths (repeated issues are grouped by location):", m_logPage);
     infoLabel->setObjectName("promptInformativeLabel");
 
-    m_logTableWidget = new QTableWidget(m_logPage);
-    m_logTableWidget->setColumnCount(2);
-    m_logTableWidget->setHorizontalHeaderLabels(QStringList() << "Path" << "Reason");
-    m_logTableWidget->horizontalHeader()->setStretchLastSection(true);
-    m_logTableWidget->verticalHeader()->setVisible(false);
-    m_logTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    m_logTableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    m_logTableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
-    m_logTableWidget->setAlternatingRowColors(true);
-    m_logTableWidget->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
-    m_logTableWidget->setMinimumHeight(200); // Set reasonable minimum height
+    m_logTableView = new QTableView(m_logPage);
+    m_logTableView->setModel(m_logModel);
+    m_logTableView->horizontalHeader()->setSectionResizeMode(ScanLogModel::PathColumn, QHeaderView::Interactive);
+    m_logTableView->horizontalHeader()->setSectionResizeMode(ScanLogModel::ReasonColumn, QHeaderView::Stretch);
+    m_logTableView->horizontalHeader()->setSectionResizeMode(ScanLogModel::CountColumn, QHeaderView::ResizeToContents);
+    m_logTableView->setColumnWidth(ScanLogModel::PathColumn, 360); // Roughly 60% for path
+    m_logTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_logTableView->verticalHeader()->setDefaultSectionSize(m_logTableView->fontMetrics().height() + 8);
+    m_logTableView->verticalHeader()->setVisible(false);
+    m_logTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_logTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_logTableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_logTableView->setAlternatingRowColors(true);
+    m_logTableView->setWordWrap(false);
+    m_logTableView->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+    m_logTableView->setMinimumHeight(200); // Set reasonable minimum height
 
     QDialogButtonBox *logButtonBox = new QDialogButtonBox(m_logPage);
     m_exportLogButton = logButtonBox->addButton("Export Log", QDialogButtonBox::ActionRole);
@@ -467,7 +552,7 @@ void ScannerDialog::setupLogPage() {
     layout->addSpacing(5);
     layout->addWidget(infoLabel);
     layout->addSpacing(10);
-    layout->addWidget(m_logTableWidget); // Removed stretch factor
+    layout->addWidget(m_logTableView); // Removed stretch factor
     layout->addSpacing(15);
     layout->addWidget(logButtonBox);
     layout->addSpacing(10);
@@ -493,17 +578,26 @@ void ScannerDialog::setupResultsPage() {
     QLabel *infoLabel = new QLabel("The following potential Softudio projects were found. Select which ones to add:", m_resultsPage);
     infoLabel->setObjectName("promptInformativeLabel");
 
-    m_resultsTableWidget = new QTableWidget(m_resultsPage);
-    m_resultsTableWidget->setColumnCount(3);
-    m_resultsTableWidget->setHorizontalHeaderLabels(QStringList() << "" << "Project Name" << "Location Path");
-    m_resultsTableWidget->horizontalHeader()->setStretchLastSection(true);
-    m_resultsTableWidget->verticalHeader()->setVisible(false);
-    m_resultsTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    m_resultsTableWidget->setSelectionMode(QAbstractItemView::NoSelection);
-    m_resultsTableWidget->setAlternatingRowColors(true);
-    m_resultsTableWidget->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
-    m_resultsTableWidget->setMinimumHeight(200); // Set reasonable minimum height
-    connect(m_resultsTableWidget, &QTableWidget::cellChanged, this, &ScannerDialog::onResultsSelectionChanged);
+    m_resultsTableView = new QTableView(m_resultsPage);
+    m_resultsTableView->setModel(m_resultsModel);
+    m_resultsTableView->horizontalHeader()->setStretchLastSection(true);
+    m_resultsTableView->horizontalHeader()->setSectionResizeMode(ScanResultsModel::CheckColumn, QHeaderView::Fixed);
+    m_resultsTableView->horizontalHeader()->setSectionResizeMode(ScanResultsModel::NameColumn, QHeaderView::Interactive);
+    m_resultsTableView->horizontalHeader()->setSectionResizeMode(ScanResultsModel::PathColumn, QHeaderView::Stretch);
+    m_resultsTableView->setColumnWidth(ScanResultsModel::CheckColumn, 35); // Checkbox column width
+    m_resultsTableView->setColumnWidth(ScanResultsModel::NameColumn, 200);
+    // Uniform row heights: a fixed section size lets the view skip per-row size hints on large result sets.
+    m_resultsTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_resultsTableView->verticalHeader()->setDefaultSectionSize(m_resultsTableView->fontMetrics().height() + 8);
+    m_resultsTableView->verticalHeader()->setVisible(false);
+    m_resultsTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_resultsTableView->setSelectionMode(QAbstractItemView::NoSelection);
+    m_resultsTableView->setAlternatingRowColors(true);
+    m_resultsTableView->setWordWrap(false);
+    m_resultsTableView->setSortingEnabled(true);
+    m_resultsTableView->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder); // Keep discovery order until the user sorts
+    m_resultsTableView->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+    m_resultsTableView->setMinimumHeight(200); // Set reasonable minimum height
 
     QHBoxLayout *selectionButtonsLayout = new QHBoxLayout();
     m_resultsSelectAllButton = new QPushButton("Select All", m_resultsPage);
@@ -515,7 +609,7 @@ void ScannerDialog::setupResultsPage() {
     selectionButtonsLayout->addWidget(m_resultsDeselectAllButton);
 
     m_resultsButtonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, m_resultsPage);
-    m_resultsButtonBox->button(QDialogButtonBox::Ok)->setEnabled(false);
+    m_resultsButtonBox->button(QDialogButtonBox::Ok)->setEnabled(m_resultsModel->checkedCount() > 0);
     m_resultsButtonBox->button(QDialogButtonBox::Ok)->setDefault(true);
     connect(m_resultsButtonBox, &QDialogButtonBox::accepted, this, &ScannerDialog::acceptProjectSelection);
     connect(m_resultsButtonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
@@ -526,7 +620,7 @@ void ScannerDialog::setupResultsPage() {
     layout->addSpacing(5);
     layout->addWidget(infoLabel);
     layout->addSpacing(10);
-    layout->addWidget(m_resultsTableWidget); // Removed stretch factor
+    layout->addWidget(m_resultsTableView); // Removed stretch factor
     layout->addSpacing(10);
     layout->addLayout(selectionButtonsLayout);
     layout->addSpacing(10);
@@ -537,8 +631,14 @@ void ScannerDialog::setupResultsPage() {
 }
 
 void ScannerDialog::loadSettings() {
-    m_quickScanRadio->setChecked(m_settings->value(SETTING_LAST_SCAN_TYPE, SCAN_TYPE_QUICK).toString() == SCAN_TYPE_QUICK);
-    m_deepScanRadio->setChecked(!m_quickScanRadio->isChecked());
+    m_loadingSettings = true;
+    const QString lastScanType = m_settings->value(SETTING_LAST_SCAN_TYPE, SCAN_TYPE_QUICK).toString();
+    m_scanBudgetSpinBox->setValue(m_settings->value(SETTING_SCAN_BUDGET_SECONDS, DEFAULT_SCAN_BUDGET_SECONDS).toInt());
+    if (lastScanType == SCAN_TYPE_DEEP) m_deepScanRadio->setChecked(true);
+    else if (lastScanType == SCAN_TYPE_BUDGETED) m_budgetedScanRadio->setChecked(true);
+    else m_quickScanRadio->setChecked(true);
+    m_scanBudgetSpinBox->setEnabled(m_budgetedScanRadio->isChecked());
+    m_backgroundScanCheckBox->setChecked(m_settings->value(SETTING_BACKGROUND_SCAN, false).toBool());
 
     QString lastScope = m_settings->value(SETTING_LAST_SCAN_SCOPE, SCAN_SCOPE_FULL_DISK).toString();
     if (lastScope == SCAN_SCOPE_FULL_DISK) m_fullDiskRadio->setChecked(true);
@@ -552,15 +652,19 @@ void ScannerDialog::loadSettings() {
     QStringList lastDrives = m_settings->value(SETTING_LAST_SELECTED_DRIVES).toStringList();
     for (int i = 0; i < m_drivesListWidget->count(); ++i) {
         QListWidgetItem *item = m_drivesListWidget->item(i);
-        if (item) { // Ensure item is valid
-             item->setCheckState(lastDrives.contains(item->text()) ? Qt::Checked : Qt::Unchecked);
+        if (item && (item->flags() & Qt::ItemIsUserCheckable)) { // Skip placeholder/unresponsive rows
+             item->setCheckState(lastDrives.contains(item->data(Qt::UserRole).toString()) ? Qt::Checked : Qt::Unchecked);
         }
     }
+    m_loadingSettings = false;
     onScanScopeChanged();
 }
 
 void ScannerDialog::saveSettings() {
+    if (m_loadingSettings) return;
     m_settings->setValue(SETTING_LAST_SCAN_TYPE, getSelectedScanType());
+    m_settings->setValue(SETTING_SCAN_BUDGET_SECONDS, m_scanBudgetSpinBox->value());
+    m_settings->setValue(SETTING_BACKGROUND_SCAN, m_backgroundScanCheckBox->isChecked());
     if(m_fullDiskRadio->isChecked()) m_settings->setValue(SETTING_LAST_SCAN_SCOPE, SCAN_SCOPE_FULL_DISK);
     else if(m_selectDrivesRadio->isChecked()) m_settings->setValue(SETTING_LAST_SCAN_SCOPE, SCAN_SCOPE_DRIVES);
     else if(m_selectFolderRadio->isChecked()) m_settings->setValue(SETTING_LAST_SCAN_SCOPE, SCAN_SCOPE_FOLDER);
@@ -571,13 +675,44 @@ void ScannerDialog::saveSettings() {
 
     QStringList selectedDrives;
     for(int i=0; i < m_drivesListWidget->count(); ++i) {
-        if(m_drivesListWidget->item(i)->checkState() == Qt::Checked) {
-            selectedDrives.append(m_drivesListWidget->item(i)->text());
+        QListWidgetItem *item = m_drivesListWidget->item(i);
+        if((item->flags() & Qt::ItemIsUserCheckable) && item->checkState() == Qt::Checked) {
+            selectedDrives.append(item->data(Qt::UserRole).toString());
+        }
+    }
+    if (m_driveDiscovery && m_driveDiscovery->isRunning()) {
+        // Drives that have not been probed yet are not in the list; don't forget them.
+        const QStringList lastDrives = m_settings->value(SETTING_LAST_SELECTED_DRIVES).toStringList();
+        for (const QString &drive : lastDrives) {
+            if (!findDriveItem(drive) && !selectedDrives.contains(drive)) selectedDrives.append(drive);
         }
     }
     m_settings->setValue(SETTING_LAST_SELECTED_DRIVES, selectedDrives);
 }
 
+void ScannerDialog::recordImportedProjects(const QList<ProjectInfo>& projects) {
+    // Imported locations weigh more than raw hits in the next walk's ordering.
+    if (m_scanInProgress) {
+        m_pendingImportHits.append(projects); // The worker rewrites the statistics when its scan ends
+        return;
+    }
+    TraversalStatistics stats = TraversalStatistics::load(*m_settings);
+    for (const ProjectInfo& project : projects) stats.recordHit(project.path, -1, TraversalStatistics::IMPORT_HIT_WEIGHT);
+    stats.save(*m_settings);
+}
+
+void ScannerDialog::journalImportedProjects(const QList<ProjectInfo>& projects) {
+    // One journal record each instead of rewriting projects.json.
+    for (const auto& proj : projects) {
+        ProjectRecord record;
+        record.path = proj.path;
+        record.name = proj.name;
+        record.uid = proj.uid;
+        record.type = proj.type;
+        ProjectJournal::shared().append(ProjectJournal::Change::UpsertProject, record);
+    }
+}
+
 void ScannerDialog::startScanThreads() {
     if (m_scanInProgress) {
         qWarning() << "ScannerDialog: Scan already in progress. Ignoring request to start new scan threads.";
@@ -587,6 +722,11 @@ void ScannerDialog::startScanThreads() {
     stopScanThreadsAndCleanup(); // Ensure any previous threads are fully stopped
 
     m_scanWorker = new ScanWorker();
+    const qint64 frontierLimitMb = m_settings->value(SETTING_FRONTIER_MEMORY_LIMIT_MB, TraversalFrontier::DEFAULT_MEMORY_LIMIT_BYTES / (1024 * 1024)).toLongLong();
+    m_scanWorker->setFrontierMemoryLimit(frontierLimitMb * 1024 * 1024);
+    m_scanWorker->setStatisticsFile(m_settings->fileName());
+    if (m_activeScanType == SCAN_TYPE_BUDGETED) m_scanWorker->setTimeBudgetMs(qint64(m_activeScanBudgetSec) * 1000);
+    m_scanWorker->setBackgroundMode(m_activeBackgroundScan);
     m_scanWorker->moveToThread(&m_scanWorkerThread);
 
     // ScanWorker connections
@@ -594,10 +734,12 @@ void ScannerDialog::startScanThreads() {
     connect(this, &ScannerDialog::requestScanWorkerStop, m_scanWorker, &ScanWorker::stopScan, Qt::DirectConnection); // Direct for immediate effect
     connect(m_scanWorker, &ScanWorker::scanProgress, this, &ScannerDialog::updateScanProgressUI);
     connect(m_scanWorker, &ScanWorker::projectFound, this, &ScannerDialog::addFoundProjectToInternalList);
+    connect(m_scanWorker, &ScanWorker::scanErrorsReported, this, &ScannerDialog::onScanErrorsReported);
     connect(m_scanWorker, &ScanWorker::scanFinished, this, &ScannerDialog::onScanWorkerFinished);
     connect(m_scanWorker, &ScanWorker::validationRequested, this, &ScannerDialog::requestValidateProject); // Connect to new signal
 
     m_validatorWorker = new ProjectFileValidatorWorker();
+    m_validatorWorker->setBackgroundMode(m_activeBackgroundScan);
     m_validatorWorker->moveToThread(&m_validatorThread);
 
     // ValidatorWorker connections
@@ -617,6 +759,7 @@ void ScannerDialog::startScanThreads() {
 void ScannerDialog::stopScanThreadsAndCleanup() {
     qDebug() << "ScannerDialog: Stopping scan threads and cleaning up...";
     m_scanInProgress = false; // Set this early
+    m_liveUpdateTimer->stop();
 
     if (m_scanWorker && m_scanWorkerThread.isRunning()) {
         qDebug() << "ScannerDialog: Requesting scan worker to stop.";
@@ -643,178 +786,139 @@ void ScannerDialog::stopScanThreadsAndCleanup() {
     qDebug() << "ScannerDialog: Scan threads cleanup attempt finished.";
 }
 
+QWidget* ScannerDialog::ensurePage(int index) {
+    switch (index) {
+    case InitialPrompt:
+        if (!m_initialPromptPage) setupInitialPromptPage();
+        return m_initialPromptPage;
+    case Configuration:
+        if (!m_configPage) setupConfigPage(); // Also starts drive discovery and loads settings
+        return m_configPage;
+    case Progress:
+        if (!m_progressPage) setupProgressPage();
+        return m_progressPage;
+    case Log:
+        if (!m_logPage) setupLogPage();
+        return m_logPage;
+    case Results:
+        if (!m_resultsPage) setupResultsPage();
+        return m_resultsPage;
+    default:
+        return nullptr;
+    }
+}
+
 void ScannerDialog::showPage(int index) {
-    if (index >= 0 && index < m_stackedWidget->count()) {
-        m_stackedWidget->setCurrentIndex(index);
+    QWidget *page = ensurePage(index);
+    if (page) {
+        if (index != Progress) setProgressAnimation(QString()); // Release frames while the progress page is hidden
+        m_stackedWidget->setCurrentWidget(page);
         adjustSize();
     } else {
         qWarning() << "ScannerDialog: Attempted to show invalid page index:" << index;
     }
 }
 
-QStringList ScannerDialog::getAvailableScanLocations() {
-    QSet<QString> drivesSet;
-
-#if defined(Q_OS_WIN)
-    DWORD logicalDrives = GetLogicalDrives();
-    for (int i = 0; i < 26; ++i) {
-        if ((logicalDrives >> i) & 1) {
-            QString driveLetter = QString(QChar('A' + i));
-            QString drivePath = driveLetter + ":\\";
-            // Check if drive is ready and accessible (GetDriveType can be more specific)
-            UINT driveType = GetDriveTypeA((drivePath.toStdString() + "\\").c_str()); // Needs trailing backslash for GetDriveType
-             if (driveType == DRIVE_FIXED || driveType == DRIVE_REMOVABLE || driveType == DRIVE_REMOTE) {
-                QFileInfo fileInfo(drivePath);
-                if (fileInfo.exists() && fileInfo.isReadable()) {
-                    drivesSet.insert(QDir::toNativeSeparators(drivePath));
-                }
-            }
-        }
-    }
-    if (!drivesSet.contains("C:\\") && QFileInfo("C:\\").exists() && QFileInfo("C:\\").isReadable()) {
-        drivesSet.insert("C:\\");
-    }
-
-#elif defined(Q_OS_LINUX) || defined(Q_OS_MACX) // Q_OS_MACX for macOS specifically
-    QStringList stdRoots;
-    stdRoots << QDir::rootPath() << QStandardPaths::writableLocation(QStandardPaths::HomeLocation);
-    if (QSysInfo::productType().toLower() == "osx" || QSysInfo::productType().toLower() == "macos") { // More robust macOS check
-        stdRoots << "/Users";
-    }
+void ScannerDialog::populateDrivesList() {
+    m_drivesListWidget->clear();
 
-    for (const QString& rPath : stdRoots) {
-        QFileInfo fi(rPath);
-        if (fi.exists() && fi.isDir() && fi.isReadable()) {
-            drivesSet.insert(QDir::toNativeSeparators(fi.canonicalFilePath()));
-        }
+    // Show the previous discovery right away; a background refresh corrects it as probes answer.
+    if (DriveDiscovery::hasCachedLocations()) {
+        const QStringList cached = DriveDiscovery::cachedLocations();
+        for (const QString &locationPath : cached) addDriveItem(locationPath);
     }
+    updateDrivesListPlaceholder();
 
-    QStringList commonMountParents;
-    commonMountParents << "/mnt" << "/media";
-     // /run/media is often user-specific, check if it exists
-    if (QDir("/run/media").exists()) commonMountParents << "/run/media";
-
-    if (QSysInfo::productType().toLower() == "osx" || QSysInfo::productType().toLower() == "macos") {
-        commonMountParents << "/Volumes";
-    }
-
-    for (const QString& parentMount : commonMountParents) {
-        QDir mountDir(parentMount);
-        if (mountDir.exists() && mountDir.isReadable()) {
-            QFileInfoList entries = mountDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::System | QDir::Hidden, QDir::Name);
-            for (const QFileInfo& entry : entries) {
-                if (entry.isReadable()) {
-                    // QStorageInfo is better for checking if it's a real mount
-                    QStorageInfo storage(entry.filePath());
-                    if (storage.isValid() && storage.isReady() && !storage.rootPath().isEmpty()) {
-                         drivesSet.insert(QDir::toNativeSeparators(storage.rootPath()));
-                    } else if (entry.isDir()) { // Fallback for older Qt or non-obvious mounts
-                         drivesSet.insert(QDir::toNativeSeparators(entry.canonicalFilePath()));
-                    }
-                }
-            }
-        }
+    if (!m_driveDiscovery) {
+        m_driveDiscovery = new DriveDiscovery(this);
+        connect(m_driveDiscovery, &DriveDiscovery::locationDiscovered, this, &ScannerDialog::onScanLocationDiscovered);
+        connect(m_driveDiscovery, &DriveDiscovery::locationUnresponsive, this, &ScannerDialog::onScanLocationUnresponsive);
+        connect(m_driveDiscovery, &DriveDiscovery::discoveryFinished, this, &ScannerDialog::onDriveDiscoveryFinished);
     }
+    m_driveDiscovery->start();
+}
 
-#if defined(Q_OS_LINUX)
-    QFile procMounts("/proc/mounts");
-    if (procMounts.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&procMounts);
-        QStringList excludedFsTypes = {"proc", "sysfs", "devtmpfs", "devpts", "tmpfs", "securityfs",
-                                     "cgroup", "pstore", "debugfs", "hugetlbfs", "mqueue",
-                                     "fuse.gvfsd-fuse", "fusectl", "tracefs", "binfmt_misc",
-                                     "configfs", "efivarfs", "snapfuse", "squashfs", "autofs", "rpc_pipefs", "overlay", "nsfs"};
-        QStringList excludedPathPrefixes = {"/dev", "/proc", "/sys", "/run/user", "/run/lock", "/boot", "/snap", "/tmp",
-                                           "/var/lib/docker", "/var/lib/snapd", "/var/tmp"};
-        while(!in.atEnd()) {
-            QString line = in.readLine().trimmed();
-            QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 3) {
-                QString device = parts[0];
-                QString mountPoint = parts[1];
-                QString fsType = parts[2];
-
-                bool isExcluded = excludedFsTypes.contains(fsType);
-                if (device.startsWith("/dev/loop") || device.startsWith("/dev/snap")) isExcluded = true; // Squashfs often via loop
-
-                for(const QString& prefix : excludedPathPrefixes) {
-                    if (mountPoint.startsWith(prefix)) {
-                        isExcluded = true;
-                        break;
-                    }
-                }
-
-                if (!isExcluded && mountPoint.startsWith("/")) {
-                    QFileInfo fi(mountPoint);
-                    QStorageInfo storage(mountPoint);
-                    if (storage.isValid() && storage.isReady() && !storage.isReadOnly() && (storage.bytesTotal() > 0 || fsType.contains("nfs") || fsType.contains("cifs")) ) { // Check if real storage
-                         drivesSet.insert(QDir::toNativeSeparators(storage.rootPath()));
-                    } else if (fi.exists() && fi.isDir() && fi.isReadable() && !storage.isValid()) { // Fallback for non-storageinfo recognized mounts
-                         drivesSet.insert(QDir::toNativeSeparators(fi.canonicalFilePath()));
-                    }
-                }
-            }
-        }
-        procMounts.close();
+QListWidgetItem* ScannerDialog::findDriveItem(const QString& path) const {
+    for (int i = 0; i < m_drivesListWidget->count(); ++i) {
+        QListWidgetItem *item = m_drivesListWidget->item(i);
+        if (item->data(Qt::UserRole).toString() == path) return item;
     }
-#endif // Q_OS_LINUX
+    return nullptr;
+}
 
-#else // Other OS (very basic fallback)
-    QFileInfoList qDrives = QDir::drives();
-    for (const QFileInfo &drive : qDrives) {
-        if(drive.isReadable()){
-            drivesSet.insert(QDir::toNativeSeparators(drive.canonicalFilePath()));
-        }
+QListWidgetItem* ScannerDialog::addDriveItem(const QString& path) {
+    QListWidgetItem *item = findDriveItem(path);
+    if (!item) {
+        item = new QListWidgetItem(path, m_drivesListWidget);
+        item->setData(Qt::UserRole, path);
     }
-#endif
+    item->setText(path);
+    item->setToolTip(QString());
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled | Qt::ItemIsSelectable);
+    const QStringList lastDrives = m_settings->value(SETTING_LAST_SELECTED_DRIVES).toStringList();
+    item->setCheckState(lastDrives.contains(path) ? Qt::Checked : Qt::Unchecked);
+    return item;
+}
 
-    if (drivesSet.isEmpty()) {
-        QString homePath = QStandardPaths::writableLocation(QStandardPaths::HomeLocation);
-        QFileInfo fiHome(homePath);
-        if (fiHome.exists() && fiHome.isDir() && fiHome.isReadable()) {
-            drivesSet.insert(QDir::toNativeSeparators(fiHome.canonicalFilePath()));
+void ScannerDialog::updateDrivesListPlaceholder() {
+    // Placeholder rows have no UserRole path; drop them once real locations exist.
+    bool hasLocations = false;
+    for (int i = m_drivesListWidget->count() - 1; i >= 0; --i) {
+        QListWidgetItem *item = m_drivesListWidget->item(i);
+        if (item->data(Qt::UserRole).toString().isEmpty()) {
+            delete m_drivesListWidget->takeItem(i);
         } else {
-            drivesSet.insert(QDir::toNativeSeparators(QDir::currentPath()));
+            hasLocations = true;
         }
     }
-    
-    QStringList driveList = drivesSet.values();
-    std::sort(driveList.begin(), driveList.end());
-    qDebug() << "ScannerDialog: Detected scannable locations:" << driveList;
-    return driveList;
-}
-
-void ScannerDialog::populateDrivesList() {
-    m_drivesListWidget->clear();
-    QStringList availableLocations = getAvailableScanLocations();
+    if (hasLocations) {
+        m_selectDrivesRadio->setEnabled(true);
+        m_fullDiskRadio->setEnabled(true);
+        return;
+    }
 
-    if (availableLocations.isEmpty()) {
-        QListWidgetItem *item = new QListWidgetItem("No scannable drives/locations found.", m_drivesListWidget);
-        item->setFlags(item->flags() & ~(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable)); // Non-interactive
+    const bool discovering = !m_driveDiscovery || m_driveDiscovery->isRunning();
+    QListWidgetItem *item = new QListWidgetItem(discovering ? "Detecting drives..." : "No scannable drives/locations found.", m_drivesListWidget);
+    item->setFlags(item->flags() & ~(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable)); // Non-interactive
+    if (!discovering) {
         m_selectDrivesRadio->setEnabled(false);
         m_fullDiskRadio->setChecked(false); // Cannot scan full disk if no drives
         m_fullDiskRadio->setEnabled(false);
         if (!m_selectFolderRadio->isChecked()) { // If nothing else, default to folder selection
             m_selectFolderRadio->setChecked(true);
         }
-        return;
     }
-    m_selectDrivesRadio->setEnabled(true);
-    m_fullDiskRadio->setEnabled(true);
+}
+
+void ScannerDialog::onScanLocationDiscovered(const QString& path) {
+    addDriveItem(path);
+    updateDrivesListPlaceholder();
+}
 
-    for (const QString &locationPath : availableLocations) {
-        QListWidgetItem *item = new QListWidgetItem(locationPath, m_drivesListWidget);
-        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
-        item->setCheckState(Qt::Unchecked);
+void ScannerDialog::onScanLocationUnresponsive(const QString& path) {
+    QListWidgetItem *item = findDriveItem(path);
+    if (!item) {
+        item = new QListWidgetItem(m_drivesListWidget);
+        item->setData(Qt::UserRole, path);
     }
-    // After populating, re-apply settings for checked drives
-    QStringList lastDrives = m_settings->value(SETTING_LAST_SELECTED_DRIVES).toStringList();
-    for (int i = 0; i < m_drivesListWidget->count(); ++i) {
+    // Shown for information only: it cannot be checked or included in a full scan.
+    item->setText(path + " (unresponsive)");
+    item->setToolTip("This mount did not respond in time and will not be scanned.");
+    item->setData(Qt::CheckStateRole, QVariant());
+    item->setFlags(item->flags() & ~(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled));
+    updateDrivesListPlaceholder();
+}
+
+void ScannerDialog::onDriveDiscoveryFinished(const QStringList& locations) {
+    // Drop cached entries that did not come back this time (unresponsive rows stay for information).
+    for (int i = m_drivesListWidget->count() - 1; i >= 0; --i) {
         QListWidgetItem *item = m_drivesListWidget->item(i);
-        if (item && lastDrives.contains(item->text())) {
-             item->setCheckState(Qt::Checked);
+        const QString path = item->data(Qt::UserRole).toString();
+        if (!path.isEmpty() && (item->flags() & Qt::ItemIsUserCheckable) && !locations.contains(path)) {
+            delete m_drivesListWidget->takeItem(i);
         }
     }
+    updateDrivesListPlaceholder();
 }
 
 QStringList ScannerDialog::getSelectedScanPaths() {
@@ -823,7 +927,7 @@ QStringList ScannerDialog::getSelectedScanPaths() {
         for(int i = 0; i < m_drivesListWidget->count(); ++i) {
             // Ensure item is valid and not the "no locations found" message
             if (m_drivesListWidget->item(i) && (m_drivesListWidget->item(i)->flags() & Qt::ItemIsUserCheckable)) {
-                 paths.append(m_drivesListWidget->item(i)->text());
+                 paths.append(m_drivesListWidget->item(i)->data(Qt::UserRole).toString());
             }
         }
         if (paths.isEmpty()) { // Should not happen if populateDrivesList enables fullDiskRadio
@@ -831,8 +935,9 @@ QStringList ScannerDialog::getSelectedScanPaths() {
         }
     } else if (m_selectDrivesRadio->isChecked()) {
         for (int i = 0; i < m_drivesListWidget->count(); ++i) {
-            if (m_drivesListWidget->item(i) && m_drivesListWidget->item(i)->checkState() == Qt::Checked) {
-                paths.append(m_drivesListWidget->item(i)->text());
+            QListWidgetItem *item = m_drivesListWidget->item(i);
+            if (item && (item->flags() & Qt::ItemIsUserCheckable) && item->checkState() == Qt::Checked) {
+                paths.append(item->data(Qt::UserRole).toString());
             }
         }
     } else if (m_selectFolderRadio->isChecked()) {
@@ -846,18 +951,28 @@ QStringList ScannerDialog::getSelectedScanPaths() {
 }
 
 QString ScannerDialog::getSelectedScanType() {
+    if (m_budgetedScanRadio->isChecked()) return SCAN_TYPE_BUDGETED;
     return m_quickScanRadio->isChecked() ? SCAN_TYPE_QUICK : SCAN_TYPE_DEEP;
 }
 
 void ScannerDialog::startActualScan() {
-    m_allFoundProjectsInternalList.clear();
-    m_validatedProjectsForResultsTable.clear();
-    m_currentScanErrors.clear();
+    ensurePage(Progress); // Widgets below are primed before the page is shown
+    m_foundPathIds.clear();
+    m_resultPathIds.clear();
+    m_resultUids.clear();
+    m_pendingResultsBatch.clear();
+    m_pendingErrors.clear();
+    m_resultsModel->clear();
+    m_logModel->clear();
+    updateLiveResultsUi();
     m_scanCancelled = false;
     m_scanInProgress = true; // Set before starting threads
     m_scanStartTime = QDateTime::currentMSecsSinceEpoch();
+    m_activeScanType = getSelectedScanType();
+    m_activeScanBudgetSec = m_scanBudgetSpinBox->value();
+    m_activeBackgroundScan = m_backgroundScanCheckBox->isChecked();
 
-    if(m_progressStatusLabel) m_progressStatusLabel->setText("Initializing scan...");
+    if(m_progressStatusLabel) m_progressStatusLabel->setText(m_activeBackgroundScan ? "Initializing background scan..." : "Initializing scan...");
     if(m_progressStatusLabel) m_progressStatusLabel->start_animation();
     if(m_progressCurrentPathLabel) m_progressCurrentPathLabel->setText(" ");
     if(m_progressBar) {
@@ -876,6 +991,8 @@ void ScannerDialog::startActualScan() {
     setProgressAnimation("Initializing");
 
     showPage(Progress);
+    m_liveUpdateTimer->start();
+    startProgressRendering();
     startScanThreads(); // This will also start validator thread
     emit requestScanWorkerStart(getSelectedScanPaths(), getSelectedScanType());
 }
@@ -906,20 +1023,26 @@ void ScannerDialog::cancelScanRequestedByProgressPage() {
     }
 }
 
-void ScannerDialog::onScanWorkerFinished(const QList<ProjectInfo>& allFoundProjectsDuringScan, const QString& outcome, const QVariantMap& extra, const QList<QPair<QString, QString>>& errors) {
+void ScannerDialog::onScanWorkerFinished(const QList<ProjectInfo>& allFoundProjectsDuringScan, const QString& outcome, const QVariantMap& extra, const ScanErrorStore& errors) {
     Q_UNUSED(allFoundProjectsDuringScan);
-    Q_UNUSED(extra); // Might use this for error messages from worker later
 
     qDebug() << "ScannerDialog: Scan worker processing finished signal. Outcome:" << outcome
-             << "Errors:" << errors.size()
-             << "Validated Projects (before this signal):" << m_validatedProjectsForResultsTable.size()
+             << "Errors:" << errors.totalCount()
+             << "Validated Projects (before this signal):" << m_resultPathIds.size()
              << "Scan Cancelled Flag:" << m_scanCancelled;
 
     m_scanInProgress = false; // Scan operations are done
+    stopProgressRendering();
+    if (!m_pendingImportHits.isEmpty()) { // The worker has saved its statistics by now
+        recordImportedProjects(m_pendingImportHits);
+        m_pendingImportHits.clear();
+    }
 
     if(m_progressStatusLabel) m_progressStatusLabel->stop_animation();
-    m_currentScanErrors.clear(); // Clear previous errors for this scan display
-    m_currentScanErrors.append(errors); // Append errors from this scan
+    // Walk errors already arrived through scanErrorsReported; push whatever is still batched.
+    // Late validation results restart the live timer through scheduleLiveUpdate().
+    flushLiveUpdates();
+    m_liveUpdateTimer->stop();
 
     // Ensure the cancel button is re-enabled and setup for next action
     if(m_progressCancelButton) {
@@ -947,10 +1070,9 @@ void ScannerDialog::onScanWorkerFinished(const QList<ProjectInfo>& allFoundProje
         if(m_progressBar) { m_progressBar->setRange(0,100); m_progressBar->setValue(0); m_progressBar->setFormat("Error"); }
         setProgressAnimation("Aborting");
         if(m_progressCancelButton) {
-            if (!m_currentScanErrors.isEmpty()) {
+            if (m_logModel->totalErrorCount() > 0) {
                 m_progressCancelButton->setText("View Log");
                 connect(m_progressCancelButton, &QPushButton::clicked, this, [this](){
-                    populateLogTable(m_currentScanErrors);
                     showPage(Log);
                 });
             } else {
@@ -963,22 +1085,25 @@ void ScannerDialog::onScanWorkerFinished(const QList<ProjectInfo>& allFoundProje
     }
 
     // Outcome is "completed"
+    const bool budgetExhausted = extra.value("budget_exhausted").toBool();
     qDebug() << "ScannerDialog: Handling COMPLETED outcome.";
-    if(m_progressStatusLabel) m_progressStatusLabel->setText("Scan Complete");
+    if (budgetExhausted) {
+        qDebug() << "ScannerDialog: Time budget used up;" << extra.value("unvisited_directories").toLongLong() << "directories left unvisited.";
+    }
+    if(m_progressStatusLabel) m_progressStatusLabel->setText(budgetExhausted ? "Scan Complete (time budget used)" : "Scan Complete");
     if(m_progressBar) {
         m_progressBar->setRange(0,1); m_progressBar->setValue(1);
-        m_progressBar->setFormat("Scan Finished");
+        m_progressBar->setFormat(budgetExhausted ? "Budget Reached" : "Scan Finished");
     }
     setProgressAnimation("Finalizing");
 
-    bool hasNewProjectsToShow = !m_validatedProjectsForResultsTable.isEmpty(); // Check after filtering known UIDs
+    bool hasNewProjectsToShow = !m_resultPathIds.isEmpty(); // Check after filtering known UIDs
 
-    if (!m_currentScanErrors.isEmpty()) {
+    if (m_logModel->totalErrorCount() > 0) {
         qDebug() << "ScannerDialog: Scan completed with errors. Progress page will offer 'View Log'.";
         if(m_progressCancelButton) {
              m_progressCancelButton->setText("View Log");
              connect(m_progressCancelButton, &QPushButton::clicked, this, [this](){
-                populateLogTable(m_currentScanErrors);
                 showPage(Log);
             });
         }
@@ -1002,48 +1127,113 @@ void ScannerDialog::onScanWorkerFinished(const QList<ProjectInfo>& allFoundProje
     }
 }
 
+namespace {
+// QLabel repaints and relayouts on every setText; skip the call when nothing changed.
+void setLabelTextIfChanged(QLabel *label, const QString &text) {
+    if (label && label->text() != text) label->setText(text);
+}
+}
+
 void ScannerDialog::updateScanProgressUI(const QString& pathMsg, int totalFoldersEst, int foldersScanned, double elapsedTime, bool isEstimating) {
-    if (m_scanCancelled || !m_scanInProgress) return; 
+    if (m_scanCancelled || !m_scanInProgress) return;
+
+    // Called at worker speed: only record the latest values, renderScanProgress() does the widget work.
+    m_progressSnapshot.pathMsg = pathMsg;
+    m_progressSnapshot.totalFoldersEst = totalFoldersEst;
+    m_progressSnapshot.foldersScanned = foldersScanned;
+    m_progressSnapshot.elapsedTime = elapsedTime;
+    m_progressSnapshot.isEstimating = isEstimating;
+    m_progressSnapshotDirty = true;
+}
+
+void ScannerDialog::startProgressRendering() {
+    // Align the render tick with the display refresh; faster updates could never be seen.
+    qreal refreshRate = screen() ? screen()->refreshRate() : 60.0;
+    if (refreshRate <= 0) refreshRate = 60.0;
+    m_progressRenderTimer->setInterval(qMax(8, qRound(1000.0 / refreshRate)));
+
+    m_progressSnapshot = ScanProgressSnapshot();
+    m_progressSnapshotDirty = false;
+    m_elidedPathSource.clear();
+    m_elidedPathWidth = -1;
+    m_lastRenderedElapsedSec = -1;
+    m_progressRenderTimer->start();
+}
+
+void ScannerDialog::stopProgressRendering() {
+    m_progressRenderTimer->stop();
+    m_progressSnapshotDirty = false;
+}
+
+void ScannerDialog::renderScanProgress() {
+    if (!m_progressSnapshotDirty || m_scanCancelled || !m_scanInProgress) return;
+    m_progressSnapshotDirty = false;
+
+    const ScanProgressSnapshot &snap = m_progressSnapshot;
 
     if (m_progressCurrentPathLabel) {
-        QFontMetrics fm(m_progressCurrentPathLabel->font());
-        QString elidedText = fm.elidedText(pathMsg, Qt::ElideLeft, m_progressCurrentPathLabel->width() - 5); 
-        m_progressCurrentPathLabel->setText(elidedText);
-        m_progressCurrentPathLabel->setToolTip(pathMsg);
+        const int availableWidth = m_progressCurrentPathLabel->width() - 5;
+        if (snap.pathMsg != m_elidedPathSource || availableWidth != m_elidedPathWidth) {
+            QFontMetrics fm(m_progressCurrentPathLabel->font());
+            m_elidedPathText = fm.elidedText(snap.pathMsg, Qt::ElideLeft, availableWidth);
+            m_elidedPathSource = snap.pathMsg;
+            m_elidedPathWidth = availableWidth;
+            setLabelTextIfChanged(m_progressCurrentPathLabel, m_elidedPathText);
+            m_progressCurrentPathLabel->setToolTip(snap.pathMsg);
+        }
     }
 
-    if (isEstimating) {
-        if(m_progressStatusLabel) m_progressStatusLabel->setText("Phase 1 of 2: Counting folders...");
-        setProgressAnimation("Initializing"); 
+    if (snap.isEstimating) {
+        if(m_progressStatusLabel) m_progressStatusLabel->setText("Phase 1 of 2: Counting folders..."); // No-op when unchanged
+        setProgressAnimation("Initializing");
         if(m_progressBar) {
-            m_progressBar->setRange(0,0); 
-            m_progressBar->setFormat(QString("Counted: %L1 folders").arg(foldersScanned));
+            if (m_progressBar->maximum() != 0 || m_progressBar->minimum() != 0) m_progressBar->setRange(0,0);
+            const QString format = QString("Counted: %L1 folders").arg(snap.foldersScanned);
+            if (m_progressBar->format() != format) m_progressBar->setFormat(format);
         }
     } else {
-        QString statusText = (getSelectedScanType() == SCAN_TYPE_DEEP) ? "Phase 2 of 2: Scanning for projects..." : "Quick Scan: Scanning for projects...";
-        if(m_progressStatusLabel) m_progressStatusLabel->setText(statusText);
+        const bool isDeep = (m_activeScanType == SCAN_TYPE_DEEP);
+        const bool isBudgeted = (m_activeScanType == SCAN_TYPE_BUDGETED);
+        if(m_progressStatusLabel) {
+            m_progressStatusLabel->setText(isDeep ? "Phase 2 of 2: Scanning for projects..."
+                                                  : isBudgeted ? "Budgeted Scan: Likely locations first..." : "Quick Scan: Scanning for projects...");
+        }
         setProgressAnimation("Scanning");
         if (m_progressBar) {
-            if (totalFoldersEst > 0 && getSelectedScanType() == SCAN_TYPE_DEEP) {
-                m_progressBar->setRange(0, totalFoldersEst);
-                m_progressBar->setValue(qMin(foldersScanned, totalFoldersEst)); 
-                double percentage = (static_cast<double>(qMin(foldersScanned, totalFoldersEst)) / totalFoldersEst) * 100.0;
-                m_progressBar->setFormat(QString("%1% (%L2/%L3)").arg(static_cast<int>(percentage)).arg(foldersScanned).arg(totalFoldersEst));
-            } else { 
-                m_progressBar->setRange(0,0); 
-                m_progressBar->setFormat(QString("Scanned: %L1 folders").arg(foldersScanned));
+            QString format;
+            if (isBudgeted && m_activeScanBudgetSec > 0) {
+                // The budget is the only known bound, so the bar tracks time spent.
+                if (m_progressBar->minimum() != 0 || m_progressBar->maximum() != m_activeScanBudgetSec) m_progressBar->setRange(0, m_activeScanBudgetSec);
+                const int spent = qMin(static_cast<int>(snap.elapsedTime), m_activeScanBudgetSec);
+                if (m_progressBar->value() != spent) m_progressBar->setValue(spent);
+                format = QString("Scanned: %L1 folders").arg(snap.foldersScanned);
+            } else if (snap.totalFoldersEst > 0 && isDeep) {
+                if (m_progressBar->minimum() != 0 || m_progressBar->maximum() != snap.totalFoldersEst) m_progressBar->setRange(0, snap.totalFoldersEst);
+                const int clamped = qMin(snap.foldersScanned, snap.totalFoldersEst);
+                if (m_progressBar->value() != clamped) m_progressBar->setValue(clamped);
+                double percentage = (static_cast<double>(clamped) / snap.totalFoldersEst) * 100.0;
+                format = QString("%1% (%L2/%L3)").arg(static_cast<int>(percentage)).arg(snap.foldersScanned).arg(snap.totalFoldersEst);
+            } else {
+                if (m_progressBar->maximum() != 0 || m_progressBar->minimum() != 0) m_progressBar->setRange(0,0);
+                format = QString("Scanned: %L1 folders").arg(snap.foldersScanned);
             }
+            if (m_progressBar->format() != format) m_progressBar->setFormat(format);
         }
     }
-    // UPDATED CALL to updateProgressETA, passing 'isEstimating'
-    updateProgressETA(elapsedTime, foldersScanned, isEstimating ? 0 : totalFoldersEst, isEstimating);
+
+    // The time label has one-second resolution; recomputing it more often cannot change it.
+    const int elapsedSec = static_cast<int>(snap.elapsedTime);
+    if (elapsedSec != m_lastRenderedElapsedSec) {
+        m_lastRenderedElapsedSec = elapsedSec;
+        updateProgressETA(snap.elapsedTime, snap.foldersScanned, snap.isEstimating ? 0 : snap.totalFoldersEst, snap.isEstimating);
+    }
 }
 
 void ScannerDialog::updateProgressETA(double elapsedTimeSec, int itemsProcessed, int itemsTotal, bool isEstimatingPhase) {
     QString elapsedStr = QTime(0,0,0).addSecs(static_cast<int>(elapsedTimeSec)).toString("HH:mm:ss");
     QString etaStr = "Calculating...";
 
-    if (itemsProcessed > 20 && elapsedTimeSec > 1 && itemsTotal > 0 && getSelectedScanType() == SCAN_TYPE_DEEP && !isEstimatingPhase) { // Check !isEstimatingPhase for deep scan phase 2
+    if (itemsProcessed > 20 && elapsedTimeSec > 1 && itemsTotal > 0 && m_activeScanType == SCAN_TYPE_DEEP && !isEstimatingPhase) { // Check !isEstimatingPhase for deep scan phase 2
         double timePerItem = elapsedTimeSec / itemsProcessed;
         int remainingItems = itemsTotal - itemsProcessed;
         if (remainingItems > 0) {
@@ -1056,49 +1246,75 @@ void ScannerDialog::updateProgressETA(double elapsedTimeSec, int itemsProcessed,
              etaStr = "Finalizing...";
         }
     // CORRECTED LINE: Use !isEstimatingPhase instead of the non-existent member
+    } else if (m_activeScanType == SCAN_TYPE_BUDGETED && m_activeScanBudgetSec > 0 && !isEstimatingPhase) {
+        const int remainingSec = qMax(0, m_activeScanBudgetSec - static_cast<int>(elapsedTimeSec));
+        etaStr = remainingSec > 0 ? QTime(0,0,0).addSecs(remainingSec).toString("HH:mm:ss") + " (budget)" : "Finishing...";
     } else if (itemsProcessed > 0 && (m_progressBar && m_progressBar->maximum() == 0) && !isEstimatingPhase) { 
         etaStr = "Scanning...";
     } else if (isEstimatingPhase){ // Explicitly check if it's the estimation phase
         etaStr = "Counting...";
     }
 
-    if(m_progressTimeEtcLabel) m_progressTimeEtcLabel->setText(QString("Elapsed: %1 | ETA: %2").arg(elapsedStr, etaStr));
+    setLabelTextIfChanged(m_progressTimeEtcLabel, QString("Elapsed: %1 | ETA: %2").arg(elapsedStr, etaStr));
 }
 
-void ScannerDialog::setProgressAnimation(const QString& stateKey) {
-    QMovie* movie = m_progressMovies.value(stateKey);
-    if (m_progressAnimationLabel) { // Ensure label exists
-        if (movie && movie->isValid()) {
-            if (m_progressAnimationLabel->movie() != movie) {
-                if (m_progressAnimationLabel->movie()) {
-                    m_progressAnimationLabel->movie()->stop();
-                }
-                m_progressAnimationLabel->setMovie(movie);
-            }
-            if(movie->state() != QMovie::Running) movie->start();
-            m_progressAnimationLabel->show();
-        } else {
-            if (m_progressAnimationLabel->movie()) {
-                m_progressAnimationLabel->movie()->stop();
-                m_progressAnimationLabel->setMovie(nullptr);
-            }
-            m_progressAnimationLabel->hide();
-            if (!movie && !stateKey.isEmpty()) qWarning() << "ScannerDialog: Animation for state" << stateKey << "not found or invalid.";
+QString ScannerDialog::progressAnimationPath(const QString& stateKey) {
+    if (m_animationPathPrefix.isEmpty()) {
+        m_animationPathPrefix = QCoreApplication::applicationDirPath() + "/Engine/Graphics/Animation/STScan.anim/";
+        if (!QDir(m_animationPathPrefix).exists()) {
+            qWarning() << "Animation path" << m_animationPathPrefix << "not found. Attempting resource path :/animations/STScan.anim/";
+            m_animationPathPrefix = ":/animations/STScan.anim/";
         }
     }
+    return m_animationPathPrefix + stateKey + ".gif";
 }
 
-void ScannerDialog::addFoundProjectToInternalList(const ProjectInfo& project) {
-    // This list collects all unique paths reported by ScanWorker before validation
-    bool exists = false;
-    for(const auto& p : m_allFoundProjectsInternalList) {
-        if(p.path == project.path) {
-            exists = true;
-            break;
-        }
+void ScannerDialog::setProgressAnimation(const QString& stateKey) {
+    // Progress renders call this every tick; an unchanged, running animation needs no lookup.
+    if (stateKey == m_currentAnimationKey) {
+        if (!m_progressAnimation) return; // Missing animations were already reported
+        if (m_progressAnimationTimer->isActive() || m_progressAnimation->frames.size() == 1) return;
+    }
+    m_currentAnimationKey = stateKey;
+    m_progressAnimationTimer->stop();
+    m_progressAnimation.reset(); // Lets the cache release the previous animation
+    if (!m_progressAnimationLabel) return;
+
+    if (!stateKey.isEmpty()) {
+        const QSize deviceSize = m_progressAnimationLabel->size() * m_progressAnimationLabel->devicePixelRatioF();
+        m_progressAnimation = AnimationFrameCache::acquire(progressAnimationPath(stateKey), deviceSize);
+        if (!m_progressAnimation) qWarning() << "ScannerDialog: Animation for state" << stateKey << "not found or invalid.";
+    }
+
+    if (m_progressAnimation) {
+        m_progressAnimationFrame = -1;
+        advanceProgressAnimation();
+        m_progressAnimationLabel->show();
+    } else {
+        m_progressAnimationLabel->clear();
+        m_progressAnimationLabel->hide();
     }
-    if(!exists) {
-        m_allFoundProjectsInternalList.append(project);
+}
+
+void ScannerDialog::advanceProgressAnimation() {
+    if (!m_progressAnimation || !m_progressAnimationLabel) return;
+    if (!isVisible()) return; // Timer is not rearmed; showEvent resumes the animation
+
+    m_progressAnimationFrame = (m_progressAnimationFrame + 1) % m_progressAnimation->frames.size();
+    QPixmap frame = m_progressAnimation->frames.at(m_progressAnimationFrame);
+    frame.setDevicePixelRatio(m_progressAnimationLabel->devicePixelRatioF());
+    m_progressAnimationLabel->setPixmap(frame);
+
+    if (m_progressAnimation->frames.size() > 1) {
+        m_progressAnimationTimer->start(m_progressAnimation->delaysMs.at(m_progressAnimationFrame));
+    }
+}
+
+void ScannerDialog::addFoundProjectToInternalList(const ProjectInfo& project) {
+    // This set collects all unique paths reported by ScanWorker before validation
+    const PathId pathId = project.pathId ? project.pathId : PathTree::shared().intern(project.path);
+    if (!m_foundPathIds.contains(pathId)) {
+        m_foundPathIds.insert(pathId);
         qDebug() << "ScannerDialog: Added to internal pre-validation list:" << project.path << "Type:" << project.type;
     }
 }
@@ -1107,6 +1323,7 @@ void ScannerDialog::onProjectFileValidated(const ProjectInfo& originalInfo, bool
 {
     ProjectInfo updatedInfo = originalInfo; // Copy original info
     updatedInfo.isValidatedSoftudioProject = isValid;
+    if (!updatedInfo.pathId) updatedInfo.pathId = PathTree::shared().intern(updatedInfo.path);
 
     if (isValid) {
         updatedInfo.name = validatedName.isEmpty() ? QFileInfo(originalInfo.path).fileName() : validatedName; // Fallback to folder name if validatedName is empty
@@ -1116,32 +1333,18 @@ void ScannerDialog::onProjectFileValidated(const ProjectInfo& originalInfo, bool
     } else {
         qDebug() << "ScannerDialog: Project NOT validated:" << updatedInfo.path << "TimedOut:" << timedOut << "Error:" << error;
         if (timedOut) {
-            m_currentScanErrors.append(QPair<QString, QString>(originalInfo.path, "Validation timed out."));
+            appendScanError(originalInfo.path, "Validation timed out.");
         } else if (!error.isEmpty()) {
-            m_currentScanErrors.append(QPair<QString, QString>(originalInfo.path, "Validation failed: " + error));
+            appendScanError(originalInfo.path, "Validation failed: " + error);
         }
         // Keep its heuristic type if it was heuristically found but failed Softudio validation.
         // If it wasn't even heuristically found and failed (e.g. direct validation attempt), mark as failed.
         if (!updatedInfo.heuristicallyFound) updatedInfo.type = "validation_failed";
     }
 
-    // Update the master list (m_allFoundProjectsInternalList) with this more detailed info
-    bool foundInAllList = false;
-    for(int i = 0; i < m_allFoundProjectsInternalList.size(); ++i) {
-        if(m_allFoundProjectsInternalList[i].path == updatedInfo.path) {
-            // Preserve original heuristic flag, then overwrite with new info
-            bool originalHeuristic = m_allFoundProjectsInternalList[i].heuristicallyFound;
-            m_allFoundProjectsInternalList[i] = updatedInfo;
-            m_allFoundProjectsInternalList[i].heuristicallyFound = originalHeuristic || updatedInfo.heuristicallyFound; // Ensure heuristic flag isn't lost
-            foundInAllList = true;
-            break;
-        }
-    }
-    if (!foundInAllList) { // Should ideally not happen if projectFound was emitted first
-        m_allFoundProjectsInternalList.append(updatedInfo);
-    }
+    m_foundPathIds.insert(updatedInfo.pathId); // Normally already there from projectFound
 
-    // Add to the list for the results table (m_validatedProjectsForResultsTable)
+    // Add to the results table
     // Only add if it's a valid Softudio project AND not in the known UIDs list.
     if(updatedInfo.isValidatedSoftudioProject) {
         if (!updatedInfo.uid.isEmpty() && m_knownProjectUids.contains(updatedInfo.uid)) {
@@ -1149,51 +1352,86 @@ void ScannerDialog::onProjectFileValidated(const ProjectInfo& originalInfo, bool
             return; // Do not add to results table if UID is known
         }
 
-        // Check for duplicates in m_validatedProjectsForResultsTable by path or UID before adding
-        bool existsInResults = false;
-        for(const auto& p_res : m_validatedProjectsForResultsTable){
-            if(p_res.path == updatedInfo.path || (!p_res.uid.isEmpty() && !updatedInfo.uid.isEmpty() && p_res.uid == updatedInfo.uid)) {
-                existsInResults = true;
-                break;
-            }
-        }
+        // Check for duplicates in the results by path or UID before adding
+        const bool existsInResults = m_resultPathIds.contains(updatedInfo.pathId)
+                                     || (!updatedInfo.uid.isEmpty() && m_resultUids.contains(updatedInfo.uid));
         if(!existsInResults) {
-            m_validatedProjectsForResultsTable.append(updatedInfo);
+            m_resultPathIds.insert(updatedInfo.pathId);
+            if (!updatedInfo.uid.isEmpty()) m_resultUids.insert(updatedInfo.uid);
+            m_pendingResultsBatch.append(updatedInfo); // Shown live on the next flush
+            scheduleLiveUpdate();
             qDebug() << "ScannerDialog: Added to results table list:" << updatedInfo.path << "Name:" << updatedInfo.name;
         }
     }
-    // Decide if you want to add purely heuristic (non-Softudio) projects to m_validatedProjectsForResultsTable here.
+    // Decide if you want to add purely heuristic (non-Softudio) projects to the results here.
     // For now, it only adds validated Softudio projects.
 }
 
-void ScannerDialog::populateLogTable(const QList<QPair<QString, QString>>& errors) {
-    m_logTableWidget->setSortingEnabled(false);
-    m_logTableWidget->clearContents();
-    m_logTableWidget->setRowCount(errors.size());
-    for (int i = 0; i < errors.size(); ++i) {
-        m_logTableWidget->setItem(i, 0, new QTableWidgetItem(QDir::toNativeSeparators(errors.at(i).first)));
-        m_logTableWidget->setItem(i, 1, new QTableWidgetItem(errors.at(i).second));
-    }
-    m_logTableWidget->resizeColumnsToContents();
-    if (m_logTableWidget->horizontalHeader()->count() == 2) { // Ensure columns exist
-        int totalWidth = m_logTableWidget->viewport()->width();
-        int pathWidth = static_cast<int>(totalWidth * 0.6); // 60% for path
-        int reasonWidth = totalWidth - pathWidth - m_logTableWidget->verticalHeader()->width() - 5; // Account for scrollbar etc.
-        
-        if (m_logTableWidget->columnWidth(0) + m_logTableWidget->columnWidth(1) < totalWidth) {
-             m_logTableWidget->setColumnWidth(0, pathWidth);
-             m_logTableWidget->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
-        } else {
-             m_logTableWidget->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Interactive);
-             m_logTableWidget->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
-        }
+void ScannerDialog::appendScanError(const QString& path, const QString& reason) {
+    m_pendingErrors.append({path, reason});
+    scheduleLiveUpdate();
+}
+
+void ScannerDialog::onScanErrorsReported(const QList<ScanError>& errors) {
+    m_pendingErrors.append(errors);
+    scheduleLiveUpdate();
+}
+
+void ScannerDialog::scheduleLiveUpdate() {
+    if (!m_liveUpdateTimer->isActive()) m_liveUpdateTimer->start();
+}
+
+void ScannerDialog::flushLiveUpdates() {
+    if (!m_scanInProgress) m_liveUpdateTimer->stop(); // After the scan it only runs until late results are shown
+    if (m_pendingResultsBatch.isEmpty() && m_pendingErrors.isEmpty()) return;
+
+    // Results only see row inserts and the log only new groups; views paint just what is visible.
+    if (!m_pendingResultsBatch.isEmpty()) {
+        m_resultsModel->appendProjects(m_pendingResultsBatch, true);
+        m_pendingResultsBatch.clear();
+    }
+    if (!m_pendingErrors.isEmpty()) {
+        m_logModel->addErrors(m_pendingErrors);
+        m_pendingErrors.clear();
+    }
+    updateLiveResultsUi();
+}
+
+void ScannerDialog::updateLiveResultsUi() {
+    const int resultCount = m_resultsModel->rowCount();
+    const qint64 issueCount = m_logModel->totalErrorCount();
+    if (m_progressLiveTabs) {
+        m_progressLiveTabs->setTabText(0, QString("Projects Found (%L1)").arg(resultCount));
+        m_progressLiveTabs->setTabText(1, QString("Issues (%L1)").arg(issueCount));
+        m_progressLiveTabs->setVisible(resultCount > 0 || issueCount > 0);
+    }
+    if (m_progressImportButton) {
+        m_progressImportButton->setVisible(resultCount > 0);
+        m_progressImportButton->setEnabled(m_resultsModel->checkedCount() > 0);
     }
-    m_logTableWidget->setSortingEnabled(true);
+}
+
+void ScannerDialog::importSelectedDuringScan() {
+    flushLiveUpdates();
+    const QList<ProjectInfo> imported = m_resultsModel->takeCheckedProjects();
+    if (imported.isEmpty()) return;
+
+    qDebug() << "ScannerDialog: Importing" << imported.size() << "project(s) while the scan continues.";
+    emit projectsSelectedForImport(imported);
+    recordImportedProjects(imported);
+    journalImportedProjects(imported);
+
+    // Imported projects are now known: keep them out of the remaining results.
+    for (const auto& proj : imported) {
+        m_resultPathIds.remove(proj.pathId);
+        if (!proj.uid.isEmpty()) m_knownProjectUids.insert(proj.uid);
+    }
+    updateLiveResultsUi();
 }
 
 void ScannerDialog::onLogDialogNextClicked(){
     // After viewing logs, decide whether to show results or close
-    bool hasNewProjectsToShow = !m_validatedProjectsForResultsTable.isEmpty();
+    bool hasNewProjectsToShow = !m_resultPathIds.isEmpty();
 
     if (!hasNewProjectsToShow) { // No new projects even after log
          qDebug() << "ScannerDialog: Log 'Next' clicked, no new projects to show.";
@@ -1207,114 +1445,103 @@ void ScannerDialog::onLogDialogNextClicked(){
 }
 
 void ScannerDialog::exportScanLog() {
+    if (m_logExportProgress) return; // One export at a time
+
     QString defaultFileName = "scan_log_" + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss") + ".txt";
+    QString selectedFilter;
     QString fileName = QFileDialog::getSaveFileName(this, "Export Scan Log",
                                                     QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + QDir::separator() + defaultFileName,
-                                                    "Text Files (*.txt);;All Files (*)");
+                                                    ScanLogExporter::fileDialogFilters(), &selectedFilter);
     if (fileName.isEmpty()) return;
 
-    QFile file(fileName);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&file);
-        out << "SOFTUDIO Project Scan Log - " << QDateTime::currentDateTime().toString(Qt::ISODate) << "\n";
-        out << "-----------------------------------------------------------------------\n\n";
-        if (m_currentScanErrors.isEmpty()) {
-            out << "No issues reported during the scan.\n";
-        } else {
-            for (const auto& errorPair : m_currentScanErrors) {
-                out << "Path: " << errorPair.first << "\n";
-                out << "Reason: " << errorPair.second << "\n\n";
-            }
-        }
-        out << "-----------------------------------------------------------------------\n";
-        out << "Scan process finished.\n";
-        file.close();
+    // The default name ends in .txt; picking another format's filter switches the extension.
+    const QRegularExpressionMatch filterMatch = QRegularExpression("\\(\\*(\\.[^)]+)\\)").match(selectedFilter);
+    if (filterMatch.hasMatch() && filterMatch.captured(1) != ".txt" && fileName.endsWith(".txt")) {
+        fileName.chop(4);
+        fileName += filterMatch.captured(1);
+    }
+    bool gzip = false;
+    const ScanLogExporter::Format format = ScanLogExporter::formatForFileName(fileName, &gzip);
+
+    if (!m_logExporter) {
+        m_logExporter = new ScanLogExporter();
+        m_logExporter->moveToThread(&m_logExportThread);
+        connect(&m_logExportThread, &QThread::finished, m_logExporter, &QObject::deleteLater);
+        connect(m_logExporter, &ScanLogExporter::progress, this, &ScannerDialog::onLogExportProgress);
+        connect(m_logExporter, &ScanLogExporter::exportFinished, this, &ScannerDialog::onLogExportFinished);
+        m_logExportThread.setObjectName("LogExportThread");
+        m_logExportThread.start(QThread::LowPriority);
+    }
+
+    flushLiveUpdates();
+    const ScanErrorStore errors = m_logModel->errorStore(); // Implicitly shared, not copied
+
+    m_logExportProgress = new QProgressDialog("Exporting scan log...", "Cancel", 0, 1000, this);
+    m_logExportProgress->setWindowTitle("Export Scan Log");
+    m_logExportProgress->setWindowModality(Qt::WindowModal);
+    m_logExportProgress->setMinimumDuration(300); // Small logs finish before the dialog appears
+    m_logExportProgress->setAutoClose(false);
+    m_logExportProgress->setAutoReset(false);
+    m_logExportProgress->setValue(0);
+    ScanLogExporter *exporter = m_logExporter;
+    connect(m_logExportProgress, &QProgressDialog::canceled, this, [exporter]() { exporter->cancel(); });
+    if (m_exportLogButton) m_exportLogButton->setEnabled(false);
+
+    QMetaObject::invokeMethod(m_logExporter, [exporter, fileName, format, gzip, errors]() {
+        exporter->exportLog(fileName, format, gzip, errors);
+    }, Qt::QueuedConnection);
+}
+
+void ScannerDialog::onLogExportProgress(qint64 recordsWritten, qint64 recordsTotal) {
+    if (!m_logExportProgress || m_logExportProgress->wasCanceled() || recordsTotal <= 0) return;
+    m_logExportProgress->setValue(static_cast<int>(recordsWritten * 1000 / recordsTotal));
+    m_logExportProgress->setLabelText(QString("Exporting scan log... %L1 of %L2 entries").arg(recordsWritten).arg(recordsTotal));
+}
+
+void ScannerDialog::onLogExportFinished(bool success, bool canceled, const QString& fileName, const QString& errorMessage) {
+    if (m_logExportProgress) {
+        m_logExportProgress->deleteLater();
+        m_logExportProgress = nullptr;
+    }
+    if (m_exportLogButton) m_exportLogButton->setEnabled(true);
+
+    if (success) {
         QMessageBox::information(this, "Export Complete", "Log exported successfully to:\n" + QDir::toNativeSeparators(fileName));
-    } else {
-        QMessageBox::warning(this, "Export Failed", "Could not write to the specified file.\nError: " + file.errorString());
+    } else if (!canceled) {
+        QMessageBox::warning(this, "Export Failed", "Could not write to the specified file.\nError: " + errorMessage);
     }
 }
 
 void ScannerDialog::populateResultsTable() {
-    m_resultsTableWidget->setSortingEnabled(false);
-    m_resultsTableWidget->clearContents();
-    m_resultsTableWidget->setRowCount(0);
-
-    // m_validatedProjectsForResultsTable should already be filtered by known UIDs in onProjectFileValidated
-    if (m_validatedProjectsForResultsTable.isEmpty()) {
+    // Rows were streamed into m_resultsModel as projects validated; only push what is still batched.
+    ensurePage(Results);
+    flushLiveUpdates();
+    if (m_resultsModel->rowCount() == 0) {
         qDebug() << "ScannerDialog: PopulateResultsTable called, but no validated projects to show.";
         // This state should ideally be handled before showing the results page,
         // but if shown, it will just be an empty table.
-        onResultsSelectionChanged(); // Ensure OK button is disabled
-        return;
     }
-    
-    m_resultsTableWidget->setRowCount(m_validatedProjectsForResultsTable.size());
-
-    for (int i = 0; i < m_validatedProjectsForResultsTable.size(); ++i) {
-        const ProjectInfo &proj = m_validatedProjectsForResultsTable.at(i);
-
-        QTableWidgetItem *checkItem = new QTableWidgetItem();
-        checkItem->setFlags(Qt::ItemIsUserCheckable | Qt::ItemIsEnabled | Qt::ItemIsSelectable);
-        checkItem->setCheckState(Qt::Checked); // Default to checked for new projects
-        m_resultsTableWidget->setItem(i, 0, checkItem);
-
-        QTableWidgetItem *nameItem = new QTableWidgetItem(proj.name);
-        nameItem->setFlags(nameItem->flags() & ~Qt::ItemIsEditable); // Read-only
-        nameItem->setData(Qt::UserRole, proj.uid); // Store UID in UserRole for easy access
-        m_resultsTableWidget->setItem(i, 1, nameItem);
-
-        QTableWidgetItem *pathItem = new QTableWidgetItem(QDir::toNativeSeparators(proj.path));
-        pathItem->setFlags(pathItem->flags() & ~Qt::ItemIsEditable); // Read-only
-        pathItem->setToolTip(QDir::toNativeSeparators(proj.path));
-        m_resultsTableWidget->setItem(i, 2, pathItem);
-    }
-    m_resultsTableWidget->resizeColumnsToContents();
-    if (m_resultsTableWidget->columnCount() > 0) m_resultsTableWidget->setColumnWidth(0, 35); // Checkbox column width
-    if (m_resultsTableWidget->columnCount() > 1) m_resultsTableWidget->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Interactive); // Name column
-    if (m_resultsTableWidget->columnCount() > 2) m_resultsTableWidget->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch); // Path column stretches
-    m_resultsTableWidget->setSortingEnabled(true);
     onResultsSelectionChanged(); // Update OK button state based on checks
 }
 
 void ScannerDialog::onResultsSelectionChanged() {
-    bool anyChecked = false;
-    for (int i = 0; i < m_resultsTableWidget->rowCount(); ++i) {
-        QTableWidgetItem* item = m_resultsTableWidget->item(i, 0); // Checkbox item
-        if (item && item->checkState() == Qt::Checked) {
-            anyChecked = true;
-            break;
-        }
-    }
+    bool anyChecked = m_resultsModel->checkedCount() > 0;
     if(m_resultsButtonBox) m_resultsButtonBox->button(QDialogButtonBox::Ok)->setEnabled(anyChecked);
+    if(m_progressImportButton) m_progressImportButton->setEnabled(anyChecked);
 }
 
 void ScannerDialog::selectAllResults(bool select) {
-    for (int i = 0; i < m_resultsTableWidget->rowCount(); ++i) {
-        QTableWidgetItem* item = m_resultsTableWidget->item(i,0);
-        if(item) { // Ensure item exists
-            item->setCheckState(select ? Qt::Checked : Qt::Unchecked);
-        }
-    }
-    onResultsSelectionChanged(); // Update OK button state
+    m_resultsModel->setAllChecked(select); // Single dataChanged range; checkedCountChanged updates the OK button
 }
 
 void ScannerDialog::acceptProjectSelection() {
-    QList<ProjectInfo> selectedProjectsList;
-    for (int i = 0; i < m_resultsTableWidget->rowCount(); ++i) {
-        QTableWidgetItem* checkItem = m_resultsTableWidget->item(i, 0);
-        if (checkItem && checkItem->checkState() == Qt::Checked) {
-             if (i < m_validatedProjectsForResultsTable.size()) {
-                 selectedProjectsList.append(m_validatedProjectsForResultsTable.at(i));
-             } else {
-                 qWarning() << "ScannerDialog: Row index out of bounds for m_validatedProjectsForResultsTable during selection.";
-             }
-        }
-    }
+    QList<ProjectInfo> selectedProjectsList = m_resultsModel->checkedProjects();
 
     if (!selectedProjectsList.isEmpty()) {
         qDebug() << "ScannerDialog: User selected" << selectedProjectsList.size() << "project(s). Emitting signal.";
         emit projectsSelectedForImport(selectedProjectsList);
+        recordImportedProjects(selectedProjectsList);
+        journalImportedProjects(selectedProjectsList);
         // Update known UIDs with the newly selected/imported projects
         for(const auto& proj : selectedProjectsList) {
             if(!proj.uid.isEmpty()) m_knownProjectUids.insert(proj.uid);
@@ -1351,17 +1578,16 @@ void ScannerDialog::closeEvent(QCloseEvent *event) {
 
 void ScannerDialog::showEvent(QShowEvent *event) {
     FramelessDialogBase::showEvent(event); // Call base first
+    QWidget *currentPage = m_stackedWidget->currentWidget();
     qDebug() << "ScannerDialog: showEvent. Current page:" << m_stackedWidget->currentIndex()
              << "Scan in progress:" << m_scanInProgress << "Scan cancelled:" << m_scanCancelled;
 
-    if(m_stackedWidget->currentIndex() == Progress && m_scanInProgress && !m_scanCancelled) {
+    if(currentPage && currentPage == m_progressPage && m_scanInProgress && !m_scanCancelled) {
         if(m_progressStatusLabel) m_progressStatusLabel->start_animation();
-        if(m_progressAnimationLabel && m_progressAnimationLabel->movie() && m_progressAnimationLabel->movie()->isValid()) {
-            if(m_progressAnimationLabel->movie()->state() != QMovie::Running) {
-                m_progressAnimationLabel->movie()->start();
-            }
+        if(m_progressAnimation && !m_progressAnimationTimer->isActive()) {
+            advanceProgressAnimation();
         }
-    } else if (m_stackedWidget->currentIndex() == InitialPrompt){
+    } else if (currentPage && currentPage == m_initialPromptPage){
         //possible future logic.
     }
     // Ensure the dialog resizes to its content on show (removed adjustSize for fixed size behavior)
@@ -3,12 +3,15 @@
 
 #include "framelessdialogbase.h"
 #include "projectinfo.h"
+#include "scanerrorstore.h"
+#include "pathtree.h"
 #include "animatedloadinglabel.h" // From SOFTUDIO project
 #include <QThread>
 #include <QList>
 #include <QVariantMap>
 #include <QListWidgetItem>
 #include <QSet> // <<< Added for known UIDs
+#include <QSharedPointer>
 
 class QLineEdit;
 class QPushButton;
@@ -16,16 +19,25 @@ class QProgressBar;
 class QLabel;
 class QCheckBox;
 class QRadioButton;
+class QSpinBox;
 class QGroupBox;
 class QTableWidget;
+class QTableView;
+class QTabWidget;
+class QTimer;
 class QDialogButtonBox;
 class QSettings;
 class QStackedWidget;
 class QListWidget;
-class QMovie;
+class QProgressDialog;
 
 class ScanWorker;
 class ProjectFileValidatorWorker;
+class ScanResultsModel;
+class ScanLogModel;
+class DriveDiscovery;
+class ScanLogExporter;
+struct AnimationFrames;
 
 
 class ScannerDialog : public FramelessDialogBase {
@@ -60,16 +72,26 @@ private slots:
     void onScanTypeChanged();
     void onScanScopeChanged();
     void onDrivesListItemChanged(QListWidgetItem* item);
+    void onScanLocationDiscovered(const QString& path);
+    void onScanLocationUnresponsive(const QString& path);
+    void onDriveDiscoveryFinished(const QStringList& locations);
 
 
     void startActualScan();
     void cancelScanRequestedByProgressPage();
-    void onScanWorkerFinished(const QList<ProjectInfo>& allFoundProjects, const QString& outcome, const QVariantMap& extra, const QList<QPair<QString, QString>>& errors);
+    void onScanWorkerFinished(const QList<ProjectInfo>& allFoundProjects, const QString& outcome, const QVariantMap& extra, const ScanErrorStore& errors);
     void updateScanProgressUI(const QString& pathMsg, int totalFoldersEst, int foldersScanned, double elapsedTime, bool isEstimating);
     void addFoundProjectToInternalList(const ProjectInfo& project);
     void onProjectFileValidated(const ProjectInfo& originalInfo, bool isValid, const QString& validatedName, const QString& validatedUid, bool timedOut, const QString& errorMessage);
+    void onScanErrorsReported(const QList<ScanError>& errors);
+    void flushLiveUpdates();
+    void advanceProgressAnimation();
+    void importSelectedDuringScan();
+    void renderScanProgress();
     void onLogDialogNextClicked();
     void exportScanLog();
+    void onLogExportProgress(qint64 recordsWritten, qint64 recordsTotal);
+    void onLogExportFinished(bool success, bool canceled, const QString& fileName, const QString& errorMessage);
 
     void onResultsSelectionChanged();
     void acceptProjectSelection();
@@ -85,20 +107,30 @@ private:
 
     void loadSettings();
     void saveSettings();
+    void recordImportedProjects(const QList<ProjectInfo>& projects); // Feeds the traversal statistics
+    void journalImportedProjects(const QList<ProjectInfo>& projects); // Into the catalog the loader reads
 
     void startScanThreads();
     void stopScanThreadsAndCleanup();
 
+    QWidget* ensurePage(int index);
     void showPage(int index);
-    void populateDrivesList(); // <<< Will be enhanced
-    QStringList getAvailableScanLocations(); // <<< NEW helper for advanced drive detection
+    void populateDrivesList();
+    QListWidgetItem* findDriveItem(const QString& path) const;
+    QListWidgetItem* addDriveItem(const QString& path);
+    void updateDrivesListPlaceholder();
     QStringList getSelectedScanPaths();
     QString getSelectedScanType();
 
     void updateProgressETA(double elapsedTimeSec, int itemsProcessed, int itemsTotal, bool isEstimatingPhase);
+    void startProgressRendering();
+    void stopProgressRendering();
     void setProgressAnimation(const QString& stateKey);
+    QString progressAnimationPath(const QString& stateKey);
 
-    void populateLogTable(const QList<QPair<QString, QString>>& errors);
+    void appendScanError(const QString& path, const QString& reason);
+    void updateLiveResultsUi();
+    void scheduleLiveUpdate(); // Restarts the flush timer for results arriving after the scan
     void populateResultsTable();
     void updateResultsOkButtonState();
 
@@ -111,6 +143,9 @@ private:
     QWidget *m_configPage;
     QRadioButton *m_quickScanRadio;
     QRadioButton *m_deepScanRadio;
+    QRadioButton *m_budgetedScanRadio;
+    QSpinBox *m_scanBudgetSpinBox;          // Seconds
+    QCheckBox *m_backgroundScanCheckBox;
     QRadioButton *m_fullDiskRadio;
     QRadioButton *m_selectDrivesRadio;
     QRadioButton *m_selectFolderRadio;
@@ -119,6 +154,7 @@ private:
     QPushButton *m_browseFolderButton;
     QWidget *m_folderSelectWidget;
     QWidget *m_drivesListContainerWidget;
+    DriveDiscovery *m_driveDiscovery;
 
 
     QWidget *m_progressPage;
@@ -128,16 +164,49 @@ private:
     QLabel *m_progressTimeEtcLabel;
     QLabel *m_progressAnimationLabel;
     QPushButton *m_progressCancelButton;
-    QMap<QString, QMovie*> m_progressMovies;
+    QTabWidget *m_progressLiveTabs;
+    QTableView *m_progressResultsView;
+    QTableView *m_progressLogView;
+    QPushButton *m_progressImportButton;
+
+    // Latest worker progress; scanProgress only overwrites it and the render timer
+    // applies it at most once per display refresh.
+    struct ScanProgressSnapshot {
+        QString pathMsg;
+        int totalFoldersEst = 0;
+        int foldersScanned = 0;
+        double elapsedTime = 0.0;
+        bool isEstimating = false;
+    };
+    ScanProgressSnapshot m_progressSnapshot;
+    bool m_progressSnapshotDirty;
+    QTimer *m_progressRenderTimer;
+    QString m_activeScanType;               // Scan type of the running scan, fixed at start
+    int m_activeScanBudgetSec;              // Budgeted scans only
+    bool m_activeBackgroundScan;
+    QString m_currentAnimationKey;
+    QSharedPointer<const AnimationFrames> m_progressAnimation; // Only the shown animation stays decoded
+    QTimer *m_progressAnimationTimer;
+    int m_progressAnimationFrame;
+    QString m_animationPathPrefix;
+    QString m_elidedPathSource;             // Elision cache for m_progressCurrentPathLabel
+    int m_elidedPathWidth;
+    QString m_elidedPathText;
+    int m_lastRenderedElapsedSec;
 
 
     QWidget *m_logPage;
-    QTableWidget *m_logTableWidget;
+    QTableView *m_logTableView;
+    ScanLogModel *m_logModel;
     QPushButton *m_exportLogButton;
+    QThread m_logExportThread;              // Started on first export, lives until the dialog closes
+    ScanLogExporter *m_logExporter;
+    QProgressDialog *m_logExportProgress;
 
 
     QWidget *m_resultsPage;
-    QTableWidget *m_resultsTableWidget;
+    QTableView *m_resultsTableView;
+    ScanResultsModel *m_resultsModel;
     QPushButton *m_resultsSelectAllButton;
     QPushButton *m_resultsDeselectAllButton;
     QDialogButtonBox *m_resultsButtonBox;
@@ -151,14 +220,22 @@ private:
     QThread m_validatorThread;
     ProjectFileValidatorWorker *m_validatorWorker;
 
-    QList<ProjectInfo> m_allFoundProjectsInternalList;
-    QList<QPair<QString, QString>> m_currentScanErrors;
-    QList<ProjectInfo> m_validatedProjectsForResultsTable;
+    // Paths are compared as PathTree ids; the ProjectInfo records themselves live in the worker and the results model.
+    QSet<PathId> m_foundPathIds;                // Everything the worker reported
+    QSet<PathId> m_resultPathIds;               // Validated and not yet imported
+    QSet<QString> m_resultUids;
+
+    // Live updates are batched and pushed into the models as row inserts on a short timer.
+    QTimer *m_liveUpdateTimer;
+    QList<ProjectInfo> m_pendingResultsBatch;
+    QList<ScanError> m_pendingErrors;
     QSet<QString> m_knownProjectUids; // <<< Added member for known UIDs
+    QList<ProjectInfo> m_pendingImportHits; // Imported mid-scan; recorded in the statistics once the scan ends
 
     bool m_scanInProgress;
     bool m_scanCancelled;
     qint64 m_scanStartTime;
+    bool m_loadingSettings; // The widgets' change signals must not save half-loaded settings
 
 
     const QString SOFTUDIO_SETTINGS_GROUP = "ProjectScanner";
@@ -167,13 +244,20 @@ private:
     const QString SETTING_LAST_SCAN_TYPE = "LastScanType";
     const QString SETTING_LAST_SCAN_SCOPE = "LastScanScope";
     const QString SETTING_LAST_SELECTED_DRIVES = "LastSelectedDrives";
+    const QString SETTING_SCAN_BUDGET_SECONDS = "ScanBudgetSeconds";
+    const QString SETTING_BACKGROUND_SCAN = "BackgroundScan";
+    const QString SETTING_FRONTIER_MEMORY_LIMIT_MB = "ScanFrontierMemoryLimitMB"; // Advanced; no UI
 
     const QString SCAN_TYPE_QUICK = "Quick Scan (Faster, checks top levels)";
     const QString SCAN_TYPE_DEEP = "Deep Scan (Slower, checks all subfolders)";
+    const QString SCAN_TYPE_BUDGETED = "Budgeted Scan (Best results first, time limited)";
+    const int DEFAULT_SCAN_BUDGET_SECONDS = 60;
     const QString SCAN_SCOPE_FULL_DISK = "Scan Full Computer";
     const QString SCAN_SCOPE_DRIVES = "Select Drives/Partitions";
     const QString SCAN_SCOPE_FOLDER = "Select Specific Folder";
 
+    const int LIVE_UPDATE_INTERVAL_MS = 250;
+
     enum Page {
         InitialPrompt = 0,
         Configuration = 1,
@@ -0,0 +1,266 @@
+#include "scanresultsmodel.h"
+
+#include <QApplication>
+#include <QStyle>
+#include <QDebug>
+#include <algorithm>
+
+ScanResultsModel::ScanResultsModel(QObject *parent)
+    : QAbstractTableModel(parent),
+      m_checkedCount(0)
+{
+    m_collator.setCaseSensitivity(Qt::CaseInsensitive);
+    m_collator.setNumericMode(true); // "Project10" after "Project9"
+}
+
+int ScanResultsModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_rowOrder.size();
+}
+
+int ScanResultsModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ScanResultsModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_rowOrder.size()) return QVariant();
+
+    const int storageIndex = m_rowOrder.at(index.row());
+    const Row &proj = m_rows.at(storageIndex);
+
+    switch (index.column()) {
+    case CheckColumn:
+        if (role == Qt::CheckStateRole) return m_checked.testBit(storageIndex) ? Qt::Checked : Qt::Unchecked;
+        break;
+    case NameColumn:
+        if (role == Qt::DisplayRole) return proj.name;
+        if (role == Qt::UserRole) return proj.uid; // UID kept reachable for delegates/consumers
+        if (role == Qt::DecorationRole) return iconForRow(proj); // Resolved here, not stored per record
+        break;
+    case PathColumn:
+        if (role == Qt::DisplayRole || role == Qt::ToolTipRole) return PathTree::shared().path(proj.pathId);
+        break;
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+bool ScanResultsModel::setData(const QModelIndex &index, const QVariant &value, int role) {
+    if (!index.isValid() || index.column() != CheckColumn || role != Qt::CheckStateRole) return false;
+
+    const int storageIndex = m_rowOrder.at(index.row());
+    const bool checked = static_cast<Qt::CheckState>(value.toInt()) == Qt::Checked;
+    if (m_checked.testBit(storageIndex) == checked) return true;
+
+    m_checked.setBit(storageIndex, checked);
+    m_checkedCount += checked ? 1 : -1;
+    emit dataChanged(index, index, {Qt::CheckStateRole});
+    emit checkedCountChanged(m_checkedCount);
+    return true;
+}
+
+Qt::ItemFlags ScanResultsModel::flags(const QModelIndex &index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    if (index.column() == CheckColumn) return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsUserCheckable;
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable; // Read-only
+}
+
+QVariant ScanResultsModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+    case CheckColumn: return QString();
+    case NameColumn:  return QStringLiteral("Project Name");
+    case PathColumn:  return QStringLiteral("Location Path");
+    default:          return QVariant();
+    }
+}
+
+void ScanResultsModel::sort(int column, Qt::SortOrder order) {
+    if (m_rowOrder.size() < 2) return;
+
+    if (column == PathColumn) ensurePathKeys();
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    const QVector<int> oldOrder = m_rowOrder;
+    auto lessThan = [this, column](int a, int b) -> bool {
+        switch (column) {
+        case CheckColumn: return m_checked.testBit(a) && !m_checked.testBit(b); // Checked rows first
+        case NameColumn:  return m_nameKeys[a].compare(m_nameKeys[b]) < 0;
+        case PathColumn:  return m_pathKeys[a].compare(m_pathKeys[b]) < 0;
+        default:          return a < b;
+        }
+    };
+    if (order == Qt::AscendingOrder) {
+        std::stable_sort(m_rowOrder.begin(), m_rowOrder.end(), lessThan);
+    } else {
+        std::stable_sort(m_rowOrder.begin(), m_rowOrder.end(), [&lessThan](int a, int b) { return lessThan(b, a); });
+    }
+
+    // Remap persistent indexes (view selection/current index) from old rows to new rows.
+    QVector<int> newRowOfStorage(m_rows.size());
+    for (int row = 0; row < m_rowOrder.size(); ++row) newRowOfStorage[m_rowOrder.at(row)] = row;
+    const QModelIndexList persistent = persistentIndexList();
+    QModelIndexList remapped;
+    remapped.reserve(persistent.size());
+    for (const QModelIndex &idx : persistent) {
+        remapped.append(index(newRowOfStorage.at(oldOrder.at(idx.row())), idx.column()));
+    }
+    changePersistentIndexList(persistent, remapped);
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+void ScanResultsModel::setProjects(const QList<ProjectInfo> &projects, bool checked) {
+    beginResetModel();
+    m_rows.clear();
+    m_nameKeys.clear();
+    m_pathKeys.clear();
+    m_rows.reserve(projects.size());
+    m_nameKeys.reserve(projects.size());
+    for (const ProjectInfo &proj : projects) appendRow(proj);
+    m_rowOrder.resize(m_rows.size());
+    for (int i = 0; i < m_rowOrder.size(); ++i) m_rowOrder[i] = i;
+    m_checked = QBitArray(m_rows.size(), checked);
+    m_checkedCount = checked ? m_rows.size() : 0;
+    endResetModel();
+
+    emit checkedCountChanged(m_checkedCount);
+}
+
+void ScanResultsModel::appendProjects(const QList<ProjectInfo> &projects, bool checked) {
+    if (projects.isEmpty()) return;
+
+    // New rows always land at the end of the view; a later header click re-sorts them in.
+    const int firstRow = m_rowOrder.size();
+    const int firstStorage = m_rows.size();
+    beginInsertRows(QModelIndex(), firstRow, firstRow + projects.size() - 1);
+    for (const ProjectInfo &proj : projects) appendRow(proj);
+    m_checked.resize(m_rows.size());
+    m_rowOrder.reserve(m_rows.size());
+    for (int i = firstStorage; i < m_rows.size(); ++i) {
+        m_rowOrder.append(i);
+        m_checked.setBit(i, checked);
+    }
+    endInsertRows();
+
+    if (checked) {
+        m_checkedCount += projects.size();
+        emit checkedCountChanged(m_checkedCount);
+    }
+}
+
+QList<ProjectInfo> ScanResultsModel::takeCheckedProjects() {
+    QList<ProjectInfo> taken = checkedProjects();
+    if (taken.isEmpty()) return taken;
+
+    // Compact storage, keys and row order in one pass; the view is reset since
+    // removed rows can be scattered anywhere after a sort.
+    beginResetModel();
+    QVector<int> newStorageIndex(m_rows.size(), -1);
+    QList<Row> keptRows;
+    std::vector<QCollatorSortKey> keptNameKeys;
+    std::vector<QCollatorSortKey> keptPathKeys;
+    const int keptCount = m_rows.size() - m_checkedCount;
+    keptRows.reserve(keptCount);
+    keptNameKeys.reserve(keptCount);
+    for (int i = 0; i < m_rows.size(); ++i) {
+        if (m_checked.testBit(i)) continue;
+        newStorageIndex[i] = keptRows.size();
+        keptRows.append(m_rows.at(i));
+        keptNameKeys.push_back(m_nameKeys[i]);
+        if (i < static_cast<int>(m_pathKeys.size())) keptPathKeys.push_back(m_pathKeys[i]); // Still a storage prefix
+    }
+    QVector<int> keptOrder;
+    keptOrder.reserve(keptCount);
+    for (int storageIndex : std::as_const(m_rowOrder)) {
+        if (newStorageIndex.at(storageIndex) >= 0) keptOrder.append(newStorageIndex.at(storageIndex));
+    }
+    m_rows = keptRows;
+    m_nameKeys.swap(keptNameKeys);
+    m_pathKeys.swap(keptPathKeys);
+    m_rowOrder = keptOrder;
+    m_checked = QBitArray(m_rows.size(), false);
+    m_checkedCount = 0;
+    endResetModel();
+
+    emit checkedCountChanged(m_checkedCount);
+    return taken;
+}
+
+void ScanResultsModel::clear() {
+    setProjects({});
+}
+
+void ScanResultsModel::setAllChecked(bool checked) {
+    if (m_rows.isEmpty()) return;
+    m_checked.fill(checked);
+    m_checkedCount = checked ? m_rows.size() : 0;
+    // One range for the whole column instead of a signal per row.
+    emit dataChanged(index(0, CheckColumn), index(m_rowOrder.size() - 1, CheckColumn), {Qt::CheckStateRole});
+    emit checkedCountChanged(m_checkedCount);
+}
+
+QList<ProjectInfo> ScanResultsModel::checkedProjects() const {
+    QList<ProjectInfo> selected;
+    selected.reserve(m_checkedCount);
+    for (int row = 0; row < m_rowOrder.size(); ++row) {
+        const int storageIndex = m_rowOrder.at(row);
+        if (m_checked.testBit(storageIndex)) selected.append(projectFor(m_rows.at(storageIndex)));
+    }
+    return selected;
+}
+
+ProjectInfo ScanResultsModel::projectAt(int row) const {
+    return projectFor(m_rows.at(m_rowOrder.at(row)));
+}
+
+ScanResultsModel::Row ScanResultsModel::rowFor(const ProjectInfo &project) {
+    Row row;
+    row.pathId = project.pathId ? project.pathId : PathTree::shared().intern(project.path);
+    row.name = project.name;
+    row.uid = project.uid;
+    row.type = project.type;
+    row.icon = project.icon;
+    row.isSoftudioProjectFlag = project.isSoftudioProjectFlag;
+    row.isValidatedSoftudioProject = project.isValidatedSoftudioProject;
+    row.heuristicallyFound = project.heuristicallyFound;
+    return row;
+}
+
+ProjectInfo ScanResultsModel::projectFor(const Row &row) {
+    ProjectInfo project; // Default constructor: no filesystem access
+    project.path = PathTree::shared().path(row.pathId);
+    project.pathId = row.pathId;
+    project.name = row.name;
+    project.uid = row.uid;
+    project.type = row.type;
+    project.icon = row.icon;
+    project.isSoftudioProjectFlag = row.isSoftudioProjectFlag;
+    project.isValidatedSoftudioProject = row.isValidatedSoftudioProject;
+    project.heuristicallyFound = row.heuristicallyFound;
+    return project;
+}
+
+void ScanResultsModel::appendRow(const ProjectInfo &project) {
+    m_rows.append(rowFor(project));
+    m_nameKeys.push_back(m_collator.sortKey(project.name));
+}
+
+void ScanResultsModel::ensurePathKeys() {
+    const PathTree &paths = PathTree::shared();
+    m_pathKeys.reserve(m_rows.size());
+    for (int i = static_cast<int>(m_pathKeys.size()); i < m_rows.size(); ++i) {
+        m_pathKeys.push_back(m_collator.sortKey(paths.path(m_rows.at(i).pathId)));
+    }
+}
+
+QIcon ScanResultsModel::iconForRow(const Row &project) const {
+    if (!project.icon.isNull()) return project.icon;
+    const bool softudio = project.isSoftudioProjectFlag || project.isValidatedSoftudioProject;
+    QIcon &icon = softudio ? m_softudioIcon : m_folderIcon;
+    if (icon.isNull()) {
+        if (softudio) icon = QApplication::windowIcon();
+        if (icon.isNull()) icon = QApplication::style()->standardIcon(QStyle::SP_DirIcon);
+    }
+    return icon;
+}
@@ -0,0 +1,87 @@
+#ifndef SCANRESULTSMODEL_H
+#define SCANRESULTSMODEL_H
+
+#include <QAbstractTableModel>
+#include <QBitArray>
+#include <QCollator>
+#include <QIcon>
+#include <QList>
+#include <QVector>
+#include <vector>
+#include "projectinfo.h"
+#include "pathtree.h"
+
+// Table model over the validated projects of a scan.
+// Rows are never copied into widget items; the view asks for what it paints.
+// Check states live in a bitset indexed by storage position, and a row-order
+// vector maps view rows onto storage so sorting never moves project data.
+// Rows reference their path through the shared PathTree; the string is only
+// built for painted cells, sorting by path, and handing projects back out.
+class ScanResultsModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        CheckColumn = 0,
+        NameColumn = 1,
+        PathColumn = 2,
+        ColumnCount = 3
+    };
+
+    explicit ScanResultsModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    void setProjects(const QList<ProjectInfo> &projects, bool checked = true);
+    void appendProjects(const QList<ProjectInfo> &projects, bool checked = true);
+    QList<ProjectInfo> takeCheckedProjects();
+    void clear();
+
+    void setAllChecked(bool checked);
+    int checkedCount() const { return m_checkedCount; }
+    QList<ProjectInfo> checkedProjects() const;
+    ProjectInfo projectAt(int row) const;
+
+signals:
+    void checkedCountChanged(int count);
+
+private:
+    struct Row {
+        PathId pathId = 0;
+        QString name;
+        QString uid;
+        QString type;
+        QIcon icon;
+        bool isSoftudioProjectFlag = false;
+        bool isValidatedSoftudioProject = false;
+        bool heuristicallyFound = false;
+    };
+
+    static Row rowFor(const ProjectInfo &project);
+    static ProjectInfo projectFor(const Row &row);
+    QIcon iconForRow(const Row &row) const;
+
+    void appendRow(const ProjectInfo &project);
+    void ensurePathKeys();
+
+    QList<Row> m_rows;                      // Storage order, append-only while populated
+    QVector<int> m_rowOrder;                // View row -> storage index
+    QBitArray m_checked;                    // Indexed by storage index
+    int m_checkedCount;
+
+    // Collation keys are computed once per project so sorting only compares bytes.
+    // Path keys are built on the first sort by path and cover a storage prefix.
+    QCollator m_collator;
+    mutable QIcon m_folderIcon;             // Shared per-type icons, created on first paint
+    mutable QIcon m_softudioIcon;
+    std::vector<QCollatorSortKey> m_nameKeys;
+    std::vector<QCollatorSortKey> m_pathKeys;
+};
+
+#endif // SCANRESULTSMODEL_H
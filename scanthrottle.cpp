@@ -0,0 +1,216 @@
+#include "scanthrottle.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QDebug>
+
+#if defined(Q_OS_LINUX)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#endif
+
+namespace {
+#if defined(Q_OS_LINUX)
+// From linux/ioprio.h, which glibc does not wrap.
+const int IOPRIO_WHO_PROCESS = 1;   // With who == 0: the calling thread
+const int IOPRIO_CLASS_SHIFT = 13;
+const int IOPRIO_CLASS_IDLE = 3;
+
+int currentThreadIoPriority() {
+    return static_cast<int>(syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, 0));
+}
+
+bool setCurrentThreadIoPriority(int priority) {
+    return syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, priority) == 0;
+}
+
+pid_t currentThreadId() {
+    return static_cast<pid_t>(syscall(SYS_gettid)); // Linux niceness is per thread
+}
+#endif
+}
+
+const int ScanThrottle::SAMPLE_INTERVAL_MS;
+const int ScanThrottle::MAX_DELAY_MS;
+
+ScanThrottle::ScanThrottle()
+    : m_lastOwnIoBytes(-1),
+      m_lastSampleMs(-1),
+      m_delayMs(0),
+      m_priorityLowered(false),
+      m_savedNice(0),
+      m_savedIoPriority(-1)
+{
+}
+
+ScanThrottle::~ScanThrottle() {
+    restorePriority();
+}
+
+bool ScanThrottle::lowerCurrentThreadPriority() {
+#if defined(Q_OS_LINUX)
+    const bool ioLowered = setCurrentThreadIoPriority(IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+    const bool cpuLowered = setpriority(PRIO_PROCESS, currentThreadId(), 19) == 0;
+    if (!ioLowered || !cpuLowered) qWarning() << "ScanThrottle: Could not fully lower thread priority (io:" << ioLowered << "cpu:" << cpuLowered << ")";
+    return ioLowered || cpuLowered;
+#elif defined(Q_OS_WIN)
+    return SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN); // Lowers I/O and memory priority too
+#else
+    QThread::currentThread()->setPriority(QThread::IdlePriority);
+    return true;
+#endif
+}
+
+int ScanThrottle::beginIdleIo() {
+#if defined(Q_OS_LINUX)
+    const int previous = currentThreadIoPriority();
+    setCurrentThreadIoPriority(IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+    return previous;
+#elif defined(Q_OS_WIN)
+    return SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN) ? 1 : -1;
+#else
+    return -1;
+#endif
+}
+
+void ScanThrottle::endIdleIo(int previousPriority) {
+    if (previousPriority < 0) return;
+#if defined(Q_OS_LINUX)
+    setCurrentThreadIoPriority(previousPriority);
+#elif defined(Q_OS_WIN)
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+#endif
+}
+
+void ScanThrottle::enterBackgroundPriority() {
+    if (m_priorityLowered) return;
+#if defined(Q_OS_LINUX)
+    m_savedIoPriority = currentThreadIoPriority();
+    errno = 0;
+    m_savedNice = getpriority(PRIO_PROCESS, currentThreadId());
+    if (errno != 0) m_savedNice = 0;
+#endif
+    m_priorityLowered = lowerCurrentThreadPriority();
+    m_sampleTimer.start();
+    m_lastDiskCounters.clear();
+    m_lastOwnIoBytes = -1;
+    m_lastSampleMs = -1;
+    m_delayMs = 0;
+}
+
+void ScanThrottle::restorePriority() {
+    if (!m_priorityLowered) return;
+#if defined(Q_OS_LINUX)
+    // Raising niceness back needs CAP_SYS_NICE on most systems; a failure just leaves the thread low.
+    if (m_savedIoPriority >= 0) setCurrentThreadIoPriority(m_savedIoPriority);
+    setpriority(PRIO_PROCESS, currentThreadId(), m_savedNice);
+#elif defined(Q_OS_WIN)
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+#else
+    QThread::currentThread()->setPriority(QThread::InheritPriority);
+#endif
+    m_priorityLowered = false;
+}
+
+qint64 ScanThrottle::ownIoBytes() {
+    // Bytes this process made the block layer read or write, all threads
+    // included: the validators run on pool threads but are part of the scan.
+    QFile ioFile(QStringLiteral("/proc/self/io"));
+    if (!ioFile.open(QIODevice::ReadOnly)) return -1;
+    qint64 bytes = 0;
+    int found = 0;
+    const QList<QByteArray> lines = ioFile.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith("read_bytes:") || line.startsWith("write_bytes:")) {
+            bytes += line.mid(line.indexOf(':') + 1).trimmed().toLongLong();
+            ++found;
+        }
+    }
+    return found == 2 ? bytes : -1;
+}
+
+bool ScanThrottle::isWholeDisk(const QString &device) {
+    // Partitions have no entry of their own in /sys/block; '/' in a name is '!' there.
+    static QHash<QString, bool> known; // Only the scan thread samples
+    auto it = known.constFind(device);
+    if (it == known.constEnd()) {
+        it = known.insert(device, QFileInfo::exists(QStringLiteral("/sys/block/") + QString(device).replace(QLatin1Char('/'), QLatin1Char('!'))));
+    }
+    return it.value();
+}
+
+bool ScanThrottle::sample(double &diskUtilization, double &loadPerCore) {
+    QFile loadFile(QStringLiteral("/proc/loadavg"));
+    QFile diskFile(QStringLiteral("/proc/diskstats"));
+    if (!loadFile.open(QIODevice::ReadOnly) || !diskFile.open(QIODevice::ReadOnly)) return false;
+
+    const QList<QByteArray> loadFields = loadFile.readAll().simplified().split(' ');
+    loadPerCore = loadFields.isEmpty() ? 0.0 : loadFields.first().toDouble() / qMax(1, QThread::idealThreadCount());
+
+    // Field 13 of /proc/diskstats is the time the device had I/O in flight;
+    // its growth over wall time is the utilization. The scan's own bytes are
+    // charged to the disk that moved the most, the one it is walking, and
+    // only the rest of that disk's traffic counts as load. The busiest device
+    // after that counts.
+    const qint64 nowMs = m_sampleTimer.elapsed();
+    const qint64 wallMs = m_lastSampleMs >= 0 ? nowMs - m_lastSampleMs : 0;
+    const qint64 ownBytes = ownIoBytes();
+    const qint64 ownDelta = ownBytes >= 0 && m_lastOwnIoBytes >= 0 ? qMax<qint64>(0, ownBytes - m_lastOwnIoBytes) : 0;
+    diskUtilization = 0.0;
+    QHash<QString, DiskCounters> counters;
+    QList<QPair<double, qint64>> deltas;           // Utilization and bytes moved, per disk
+    int ownDisk = -1;
+    const QList<QByteArray> lines = diskFile.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        const QList<QByteArray> fields = line.simplified().split(' ');
+        if (fields.size() < 13) continue;
+        const QString device = QString::fromLatin1(fields.at(2));
+        if (device.startsWith(QLatin1String("loop")) || device.startsWith(QLatin1String("ram")) || device.startsWith(QLatin1String("zram"))) continue;
+        if (!isWholeDisk(device)) continue;
+        DiskCounters current;
+        current.ioTicks = fields.at(12).toLongLong();
+        current.sectors = fields.at(5).toLongLong() + fields.at(9).toLongLong();
+        counters.insert(device, current);
+        const auto previous = m_lastDiskCounters.constFind(device);
+        if (wallMs > 0 && previous != m_lastDiskCounters.constEnd()) {
+            deltas.append(qMakePair(double(current.ioTicks - previous->ioTicks) / wallMs,
+                                    (current.sectors - previous->sectors) * 512));
+            if (ownDisk < 0 || deltas.last().second > deltas.at(ownDisk).second) ownDisk = deltas.size() - 1;
+        }
+    }
+    for (int i = 0; i < deltas.size(); ++i) {
+        double utilization = deltas.at(i).first;
+        const qint64 bytes = deltas.at(i).second;
+        if (i == ownDisk && bytes > 0) utilization *= double(qMax<qint64>(0, bytes - ownDelta)) / bytes;
+        diskUtilization = qMax(diskUtilization, utilization);
+    }
+    m_lastDiskCounters.swap(counters);
+    m_lastOwnIoBytes = ownBytes;
+    m_lastSampleMs = nowMs;
+    return wallMs > 0;
+}
+
+void ScanThrottle::pace() {
+    if (!m_sampleTimer.isValid()) m_sampleTimer.start();
+    if (m_lastSampleMs < 0 || m_sampleTimer.elapsed() - m_lastSampleMs >= SAMPLE_INTERVAL_MS) {
+        double diskUtilization = 0.0;
+        double loadPerCore = 0.0;
+        if (sample(diskUtilization, loadPerCore)) {
+            const int previousDelay = m_delayMs;
+            const bool busy = diskUtilization > DISK_BUSY_UTILIZATION || loadPerCore > CPU_BUSY_LOAD_PER_CORE;
+            // Back off fast, recover gradually.
+            if (busy) m_delayMs = qBound(1, m_delayMs * 2, MAX_DELAY_MS);
+            else m_delayMs /= 2;
+            if ((previousDelay == 0) != (m_delayMs == 0)) {
+                qDebug() << "ScanThrottle:" << (m_delayMs ? "Backing off" : "Resuming full speed")
+                         << "- disk utilization:" << diskUtilization << "load per core:" << loadPerCore;
+            }
+        }
+    }
+    if (m_delayMs > 0) QThread::msleep(static_cast<unsigned long>(m_delayMs));
+}
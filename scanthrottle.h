@@ -0,0 +1,59 @@
+#ifndef SCANTHROTTLE_H
+#define SCANTHROTTLE_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+
+// Keeps a background scan out of the way of foreground work.
+// enterBackgroundPriority() puts the calling thread in the idle I/O class and
+// at the lowest CPU niceness (background mode on Windows); beginIdleIo() only
+// changes the I/O class, for pool threads that must be handed back intact.
+// pace() is called once per directory: it samples /proc/diskstats and
+// /proc/loadavg every SAMPLE_INTERVAL_MS and sleeps for an adaptive delay that
+// doubles while the disks or CPUs are busy and decays back to zero once they
+// are idle. The process's own I/O (/proc/self/io) is taken out of the disk
+// load first, so the scan never backs off from itself. Where those files do
+// not exist only the priority change applies.
+class ScanThrottle {
+public:
+    ScanThrottle();
+    ~ScanThrottle();
+
+    void enterBackgroundPriority();
+    void restorePriority();
+    void pace();
+
+    int currentDelayMs() const { return m_delayMs; }
+
+    // For borrowed (thread pool) threads: only the I/O class, which can be undone.
+    static int beginIdleIo();               // Returns the previous priority for endIdleIo()
+    static void endIdleIo(int previousPriority);
+
+    static const int SAMPLE_INTERVAL_MS = 500;
+    static const int MAX_DELAY_MS = 100;            // Per directory; the scan always keeps moving
+    static constexpr double DISK_BUSY_UTILIZATION = 0.5;
+    static constexpr double CPU_BUSY_LOAD_PER_CORE = 0.75;
+
+private:
+    struct DiskCounters {
+        qint64 ioTicks = 0;                         // ms spent doing I/O
+        qint64 sectors = 0;                         // Read and written, in 512-byte units
+    };
+
+    static bool lowerCurrentThreadPriority();
+    static qint64 ownIoBytes();                     // -1 if unknown
+    static bool isWholeDisk(const QString &device);
+    bool sample(double &diskUtilization, double &loadPerCore);
+
+    QElapsedTimer m_sampleTimer;
+    QHash<QString, DiskCounters> m_lastDiskCounters; // Whole disks only; partitions repeat their disk
+    qint64 m_lastOwnIoBytes;
+    qint64 m_lastSampleMs;
+    int m_delayMs;
+    bool m_priorityLowered;
+    int m_savedNice;
+    int m_savedIoPriority;
+};
+
+#endif // SCANTHROTTLE_H
@@ -9,6 +9,51 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QTimer> // <<< Added for QTimer
+#include "traversalfrontier.h"
+#include "instantcandidatefinder.h"
+#include "startuptrace.h"
+#include <QStandardPaths>
+#include <QSettings>
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+namespace {
+struct PrioritizedDirectory {
+    int score;
+    quint64 sequence;   // Breaks ties first-in first-out, i.e. breadth-first
+    QString path;
+    int depth;          // Below the scan root
+    int priorityDepth;  // Depth the score is charged for; seeds restart at 0
+};
+
+struct VisitLater {
+    bool operator()(const PrioritizedDirectory& a, const PrioritizedDirectory& b) const {
+        return a.score != b.score ? a.score > b.score : a.sequence > b.sequence;
+    }
+};
+
+bool isSameOrUnder(const QString& path, const QString& rootPath) {
+#if defined(Q_OS_WIN)
+    const Qt::CaseSensitivity cs = Qt::CaseInsensitive;
+#else
+    const Qt::CaseSensitivity cs = Qt::CaseSensitive;
+#endif
+    if (!path.startsWith(rootPath, cs)) return false;
+    if (path.size() == rootPath.size()) return true;
+    const QChar sep = QDir::separator();
+    return rootPath.endsWith(sep) || path.at(rootPath.size()) == sep;
+}
+
+// Levels between a root and a native path at or under it.
+int depthBelow(const QString& path, const QString& rootPath) {
+    if (path.size() <= rootPath.size()) return 0;
+    const QStringView relative = QStringView(path).mid(rootPath.size());
+    int depth = int(relative.count(QDir::separator()));
+    if (!relative.startsWith(QDir::separator())) ++depth; // Root ends in a separator, e.g. "/"
+    return depth;
+}
+}
 
 ScanWorker::ScanWorker(QObject *parent)
     : QObject(parent),
@@ -17,7 +62,15 @@ ScanWorker::ScanWorker(QObject *parent)
       m_foldersScannedCount(0),
       m_currentScanRootIndex(0),
       m_totalScanRoots(0),
-      m_isCurrentlyEstimatingForPeriodicEmit(false)
+      m_isCurrentlyEstimatingForPeriodicEmit(false),
+      m_frontierMemoryLimit(TraversalFrontier::DEFAULT_MEMORY_LIMIT_BYTES),
+      m_timeBudgetMs(0),
+      m_budgetExhausted(false),
+      m_frontierRemaining(0),
+      m_frontierLost(0),
+      m_quickScanDepthLimit(0), // Set by loadTraversalStatistics() when a scan starts
+      m_currentVisitDepth(0),
+      m_backgroundMode(false)
 {
     m_progressUpdateTimer = new QTimer(this);
     connect(m_progressUpdateTimer, &QTimer::timeout, this, &ScanWorker::_emitPeriodicProgress);
@@ -29,6 +82,58 @@ ScanWorker::~ScanWorker()
     // m_progressUpdateTimer is a child of ScanWorker, will be deleted automatically
 }
 
+void ScanWorker::setFrontierMemoryLimit(qint64 bytes) {
+    m_frontierMemoryLimit = bytes; // Read when the next walk starts
+}
+
+void ScanWorker::setTimeBudgetMs(qint64 ms) {
+    m_timeBudgetMs = ms;
+}
+
+void ScanWorker::setStatisticsFile(const QString& settingsFileName) {
+    m_statisticsFile = settingsFileName;
+}
+
+void ScanWorker::setBackgroundMode(bool enabled) {
+    m_backgroundMode = enabled;
+}
+
+void ScanWorker::loadTraversalStatistics() {
+    StartupTrace::Zone zone("Load traversal statistics", "scan");
+    m_statistics = TraversalStatistics();
+    m_quickScanDepthLimit = QUICK_SCAN_DEPTH_LIMIT;
+    if (m_statisticsFile.isEmpty()) return;
+
+    QSettings settings(m_statisticsFile, QSettings::IniFormat);
+    m_statistics = TraversalStatistics::load(settings);
+    m_statistics.decay(); // Older scans count for less than the one about to run
+    m_quickScanDepthLimit = m_statistics.suggestedQuickDepth(QUICK_SCAN_DEPTH_LIMIT, QUICK_SCAN_MAX_LEARNED_DEPTH);
+    if (m_quickScanDepthLimit != QUICK_SCAN_DEPTH_LIMIT) {
+        qDebug() << "ScanWorker: Quick Scan depth raised to" << m_quickScanDepthLimit << "from past hit depths.";
+    }
+}
+
+void ScanWorker::updateTraversalStatistics() {
+    StartupTrace::Zone zone("Save traversal statistics", "scan");
+    // Barren directories are only known when the walk below them was complete.
+    if (!m_stopRequested && !m_budgetExhausted && m_frontierLost == 0) {
+        QSet<QString> hitAncestors;
+        for (const ProjectInfo& project : std::as_const(m_foundProjectsList)) {
+            for (QString dir = project.path; !dir.isEmpty() && !hitAncestors.contains(dir); dir = TraversalStatistics::parentOf(dir)) {
+                hitAncestors.insert(dir);
+            }
+        }
+        for (const QString& dir : std::as_const(m_shallowVisited)) {
+            if (!hitAncestors.contains(dir)) m_statistics.recordBarren(dir);
+        }
+    }
+    m_shallowVisited.clear();
+
+    if (m_statisticsFile.isEmpty()) return;
+    QSettings settings(m_statisticsFile, QSettings::IniFormat);
+    m_statistics.save(settings);
+}
+
 void ScanWorker::stopScan() {
     m_stopRequested = true;
     if (m_progressUpdateTimer->isActive()) {
@@ -39,6 +144,8 @@ void ScanWorker::stopScan() {
 void ScanWorker::_emitPeriodicProgress() {
     if (m_stopRequested) return;
 
+    flushPendingErrors();
+
     emit scanProgress(
         m_lastProcessedPathForPeriodicEmit,
         m_scanType == SCAN_TYPE_DEEP ? m_totalFoldersEstimate : 0, // Only provide total estimate for deep scan
@@ -49,15 +156,24 @@ void ScanWorker::_emitPeriodicProgress() {
 }
 
 void ScanWorker::doScan(const QList<QString> &scanRoots, const QString &scanType) {
+    StartupTrace::Zone zone("Scan", scanType, "scan");
     m_scanRoots = scanRoots;
     m_scanType = scanType;
     m_stopRequested = false;
     m_totalFoldersEstimate = 0;
     m_foldersScannedCount = 0;
     m_foundProjectsList.clear();
+    m_foundPathIds.clear();
     m_scanErrors.clear();
+    m_pendingErrors.clear();
     m_currentScanRootIndex = 0;
     m_totalScanRoots = m_scanRoots.size();
+    m_budgetExhausted = false;
+    m_frontierRemaining = 0;
+    m_frontierLost = 0;
+    m_shallowVisited.clear();
+    m_currentVisitDepth = 0;
+    loadTraversalStatistics();
     m_scanTimer.start();
     m_lastProcessedPathForPeriodicEmit = "Initializing scan...";
     m_isCurrentlyEstimatingForPeriodicEmit = (m_scanType == SCAN_TYPE_DEEP);
@@ -71,7 +187,9 @@ void ScanWorker::doScan(const QList<QString> &scanRoots, const QString &scanType
         return;
     }
 
+    if (m_backgroundMode) m_throttle.enterBackgroundPriority();
     performScan();
+    m_throttle.restorePriority(); // The thread is reused for the next scan
 
     if (m_progressUpdateTimer->isActive()) {
         m_progressUpdateTimer->stop();
@@ -87,14 +205,21 @@ void ScanWorker::doScan(const QList<QString> &scanRoots, const QString &scanType
         emit scanProgress("Scan canceled.", m_totalFoldersEstimate, m_foldersScannedCount, m_scanTimer.elapsed() / 1000.0, false);
     } else {
         // Emit final progress for completion
-        emit scanProgress("Scan complete.", m_totalFoldersEstimate, m_foldersScannedCount, m_scanTimer.elapsed() / 1000.0, false);
+        emit scanProgress(m_budgetExhausted ? "Scan budget used up." : "Scan complete.", m_totalFoldersEstimate, m_foldersScannedCount, m_scanTimer.elapsed() / 1000.0, false);
+    }
+    if (m_scanType == SCAN_TYPE_BUDGETED) {
+        extra["budget_exhausted"] = m_budgetExhausted;
+        extra["unvisited_directories"] = m_frontierRemaining;
     }
 
 
+    updateTraversalStatistics();
+    flushPendingErrors(); // Listeners see every error before scanFinished
     emit scanFinished(m_foundProjectsList, outcome, extra, m_scanErrors);
 }
 
 void ScanWorker::countTotalFolders() {
+    StartupTrace::Zone zone("Count folders", "scan");
     m_totalFoldersEstimate = 0;
     m_isCurrentlyEstimatingForPeriodicEmit = true;
     m_lastProcessedPathForPeriodicEmit = "Counting folders (Phase 1/2)...";
@@ -105,6 +230,7 @@ void ScanWorker::countTotalFolders() {
         QDirIterator it(rootPath, QDir::Dirs | QDir::NoDotAndDotDot | QDir::Readable | QDir::Hidden | QDir::System, QDirIterator::Subdirectories);
         while (it.hasNext()) {
             if (m_stopRequested) return;
+            if (m_backgroundMode) m_throttle.pace();
             QString currentPath = it.next();
             m_totalFoldersEstimate++;
             m_lastProcessedPathForPeriodicEmit = currentPath; // Update for timer based emit
@@ -122,7 +248,34 @@ void ScanWorker::countTotalFolders() {
 }
 
 
+void ScanWorker::collectInstantCandidates() {
+    StartupTrace::Zone zone("Instant candidates", "scan");
+    // Locate databases and the recent-files list name likely projects without
+    // touching the disk; they go to validation now and the walk later skips
+    // them through m_foundPathIds.
+    m_lastProcessedPathForPeriodicEmit = "Checking indexed and recently used locations...";
+    emit scanProgress(m_lastProcessedPathForPeriodicEmit, 0, 0, m_scanTimer.elapsed() / 1000.0, false);
+    QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+
+    const InstantCandidateFinder finder(SOFTUDIO_NESTED_PATH_PARTS);
+    const QStringList roots = finder.fromLocateDatabase(m_scanRoots) + finder.fromRecentFiles(m_scanRoots);
+    m_currentVisitDepth = -1; // Not found by the walk: no depth to learn from
+    int reported = 0;
+    for (const QString& root : roots) {
+        if (m_stopRequested) return;
+        DirectoryCandidate candidate(root);
+        candidate.type = ProjectType::SoftudioPotential;
+        const int before = m_foundProjectsList.size();
+        reportFoundProject(candidate);
+        if (m_foundProjectsList.size() > before) ++reported;
+    }
+    qDebug() << "ScanWorker: Instant candidates sent to validation:" << reported << "in" << m_scanTimer.elapsed() << "ms.";
+}
+
 void ScanWorker::performScan() {
+    collectInstantCandidates();
+    if (m_stopRequested) return;
+
     if (m_scanType == SCAN_TYPE_DEEP) {
         m_lastProcessedPathForPeriodicEmit = "Phase 1/2: Counting total folders...";
         emit scanProgress(m_lastProcessedPathForPeriodicEmit, 0, 0, m_scanTimer.elapsed() / 1000.0, true);
@@ -138,6 +291,15 @@ void ScanWorker::performScan() {
     m_lastProcessedPathForPeriodicEmit = "Phase 2/2: Scanning for projects...";
     if (m_scanType == SCAN_TYPE_QUICK) m_lastProcessedPathForPeriodicEmit = "Quick Scan: Scanning for projects...";
 
+    if (m_scanType == SCAN_TYPE_BUDGETED) {
+        // One prioritized walk over all roots, so likely spots on any root come first.
+        m_lastProcessedPathForPeriodicEmit = "Budgeted Scan: Scanning likely locations first...";
+        emit scanProgress(m_lastProcessedPathForPeriodicEmit, 0, 0, m_scanTimer.elapsed() / 1000.0, false);
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+        walkPrioritized();
+        return;
+    }
+
 
     for (m_currentScanRootIndex = 0; m_currentScanRootIndex < m_totalScanRoots; ++m_currentScanRootIndex) {
         if (m_stopRequested) break;
@@ -156,14 +318,89 @@ void ScanWorker::performScan() {
                           m_scanTimer.elapsed() / 1000.0,
                           false); // Not estimating anymore
         QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        processDirectory(QDir::toNativeSeparators(rootPath), 0);
+        walkTree(QDir::toNativeSeparators(rootPath));
     }
 }
 
-void ScanWorker::processDirectory(const QString& directoryPath, int currentDepth) {
-    if (m_stopRequested) return;
+void ScanWorker::walkTree(const QString& rootPath) {
+    StartupTrace::Zone zone("Walk tree", rootPath, "scan");
+    // Explicit stack instead of recursion: depth is bounded by nothing but the
+    // filesystem, and each directory's children go from QDirIterator onto the
+    // frontier, which spills to disk past its memory budget.
+    // Children are pushed in reversed chunks of CHILD_PUSH_CHUNK, so they pop
+    // in listing order within a chunk and a very wide directory never sits in
+    // memory whole. Learned statistics reorder them: children under past hits
+    // are pushed last so they pop first, and barren subtrees wait in a second
+    // frontier until everything else is done.
+    TraversalFrontier frontier(m_frontierMemoryLimit);
+    TraversalFrontier barrenFrontier(m_frontierMemoryLimit);
+    frontier.push(rootPath, 0);
+
+    TraversalFrontier::Entry entry;
+    QStringList children;           // At most one chunk, until pushed
+    QStringList barrenChildren;
+    auto pushReversed = [](TraversalFrontier& target, QStringList& paths, int depth) {
+        for (auto it = paths.crbegin(); it != paths.crend(); ++it) target.push(*it, depth);
+        paths.clear();
+    };
+    QList<TraversalFrontier::Entry> richChildren;
+    while (!m_stopRequested && (frontier.pop(entry) || barrenFrontier.pop(entry))) {
+        if (!visitDirectory(entry.path, entry.depth)) continue;
+
+        QDirIterator it(entry.path, QDir::Dirs | QDir::NoDotAndDotDot | QDir::Readable | QDir::Hidden | QDir::System);
+        while (it.hasNext()) {
+            if (m_stopRequested) break;
+            const QFileInfo child = it.nextFileInfo();
+            // Avoid following symlinks to dirs for now to prevent loops/massive scans
+            if (!child.isDir() || child.isSymLink()) continue;
+            const QString childPath = QDir::toNativeSeparators(child.absoluteFilePath());
+            if (m_statistics.isEmpty()) {
+                children.append(childPath);
+            } else if (m_statistics.richness(childPath) > 0) {
+                richChildren.append({childPath, entry.depth + 1}); // Bounded by the statistics size
+            } else if (m_statistics.isBarren(childPath)) {
+                barrenChildren.append(childPath);
+            } else {
+                children.append(childPath);
+            }
+            if (children.size() >= CHILD_PUSH_CHUNK) pushReversed(frontier, children, entry.depth + 1);
+            if (barrenChildren.size() >= CHILD_PUSH_CHUNK) pushReversed(barrenFrontier, barrenChildren, entry.depth + 1);
+        }
+        pushReversed(frontier, children, entry.depth + 1);
+        pushReversed(barrenFrontier, barrenChildren, entry.depth + 1);
+        if (!richChildren.isEmpty()) {
+            std::stable_sort(richChildren.begin(), richChildren.end(), [this](const TraversalFrontier::Entry& a, const TraversalFrontier::Entry& b) {
+                return m_statistics.richness(a.path) > m_statistics.richness(b.path);
+            });
+            // Richest pushed last, popped first; ties keep listing order.
+            for (auto it = richChildren.crbegin(); it != richChildren.crend(); ++it) frontier.push(it->path, it->depth);
+            richChildren.clear();
+        }
+    }
+
+    const int spills = frontier.spillCount() + barrenFrontier.spillCount();
+    if (spills > 0) {
+        qDebug() << "ScanWorker: Frontier for" << rootPath << "spilled to disk" << spills << "time(s).";
+    }
+    reportFrontierError(rootPath, frontier);
+    reportFrontierError(rootPath, barrenFrontier);
+}
+
+void ScanWorker::reportFrontierError(const QString& rootPath, const TraversalFrontier& frontier) {
+    if (!frontier.hasError()) return;
+    QString message = "Scan frontier spill file failed: " + frontier.errorString();
+    if (frontier.lostCount() > 0) {
+        // The lost paths themselves are unknown; the count is all there is to report.
+        m_frontierLost += frontier.lostCount();
+        message += QString(". %L1 queued folder(s) could not be read back; their subtrees were not scanned.").arg(frontier.lostCount());
+    }
+    handleWalkError(rootPath, message);
+}
+
+bool ScanWorker::visitDirectory(const QString& directoryPath, int currentDepth) {
+    if (m_stopRequested) return false;
+    if (m_backgroundMode) m_throttle.pace();
 
-    QDir dir(directoryPath);
     // Skip non-existent or unreadable directories. Links could also be an issue.
     // Using QFileInfo to better handle symlinks and permissions.
     QFileInfo dirInfo(directoryPath);
@@ -175,7 +412,7 @@ void ScanWorker::processDirectory(const QString& directoryPath, int currentDepth
         } else if (!dirInfo.exists()){ // Does not exist (e.g. broken symlink)
             // Often fine to ignore broken symlinks
         }
-        return;
+        return false;
     }
 
 
@@ -192,78 +429,171 @@ void ScanWorker::processDirectory(const QString& directoryPath, int currentDepth
          QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
     }
 
-    ProjectInfo projectInfo(QDir::toNativeSeparators(directoryPath));
-    bool isPotentialSoftudio = checkForSoftudioProject(directoryPath, projectInfo);
-
-    if (isPotentialSoftudio) {
-        projectInfo.isSoftudioProjectFlag = true; // Mark as potential, validation will confirm
-        projectInfo.type = "softudio_potential"; // Intermediate type
-        
-        bool alreadyFound = false;
-        for(const auto& p : m_foundProjectsList) { // Check against m_foundProjectsList
-            if(p.path == projectInfo.path) {
-                alreadyFound = true;
-                break;
-            }
-        }
-        
-        if(!alreadyFound) {
-            m_foundProjectsList.append(projectInfo);
-            emit projectFound(projectInfo); // Let dialog know about raw find
-            emit validationRequested(projectInfo); // Request full validation
-        }
+    DirectoryCandidate candidate(QDir::toNativeSeparators(directoryPath));
+    m_currentVisitDepth = currentDepth;
+    if (currentDepth >= 1 && currentDepth <= BARREN_TRACK_DEPTH && m_shallowVisited.size() < MAX_SHALLOW_TRACKED) {
+        m_shallowVisited.append(candidate.path);
+    }
+    if (checkForSoftudioProject(directoryPath, candidate)) {
+        // Marked as potential; validation will confirm
+        reportFoundProject(candidate);
         // For Softudio projects, we typically don't need to scan subdirs further for other projects
-        return; 
+        return false;
     }
 
     // Heuristic check only if not a Softudio project at this level
     // And only if within depth limits for quick scan
-    if (m_scanType == SCAN_TYPE_DEEP || (m_scanType == SCAN_TYPE_QUICK && currentDepth < QUICK_SCAN_DEPTH_LIMIT)) {
-        checkForHeuristicProjects(directoryPath, projectInfo); // projectInfo might be updated
-        if(projectInfo.heuristicallyFound) {
-             bool alreadyFound = false;
-             for(const auto& p : m_foundProjectsList) if(p.path == projectInfo.path) alreadyFound = true;
-             if(!alreadyFound) {
-                m_foundProjectsList.append(projectInfo); // Add heuristic find to master list
-                emit projectFound(projectInfo); // Let dialog know (it might ignore if validation is pending for same path)
-                // No validationRequested for purely heuristic finds unless you decide to
-             }
+    if (shouldDescend(candidate.path, currentDepth)) {
+        checkForHeuristicProjects(directoryPath, candidate);
+        if (candidate.isProject()) {
+             // No validationRequested for purely heuristic finds unless you decide to
+             reportFoundProject(candidate);
              // If heuristic project is found, often we don't need to go deeper in this branch either
              // depending on desired behavior (e.g. a .git folder implies the root of that project type)
              // For now, let it continue to find nested Softudio projects if any.
         }
     }
 
-    // Recurse if deep scan or quick scan within depth
-    if (m_scanType == SCAN_TYPE_DEEP || (m_scanType == SCAN_TYPE_QUICK && currentDepth < QUICK_SCAN_DEPTH_LIMIT)) {
-        QFileInfoList entries = dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Readable | QDir::Hidden | QDir::System, QDir::Name | QDir::DirsFirst);
-        for (const QFileInfo &entry : entries) {
-            if (m_stopRequested) return;
-            // Basic protection against re-entrant symlinks, though QDirIterator is often better.
-            // Here, we rely on QFileInfo::isDir() and that QDir doesn't list "." or ".." by default with NoDotAndDotDot.
-            if (entry.isDir() && !entry.isSymbolicLink()) { // Avoid following symlinks to dirs for now to prevent loops/massive scans
-                processDirectory(entry.absoluteFilePath(), currentDepth + 1);
-            }
-            // If you want to follow symlinks to directories:
-            // else if (entry.isDir()) { // This would include symlinks to dirs
-            //    processDirectory(entry.canonicalFilePath(), currentDepth + 1); // canonicalFilePath resolves symlink
-            // }
-        }
+    // Descend if deep/budgeted scan or quick scan within depth
+    return shouldDescend(candidate.path, currentDepth);
+}
+
+bool ScanWorker::shouldDescend(const QString& directoryPath, int currentDepth) const {
+    if (m_scanType != SCAN_TYPE_QUICK) return true; // Deep and budgeted scans have no depth limit
+    if (currentDepth < m_quickScanDepthLimit) return true;
+    // Past the limit, keep going only where projects were found before.
+    return currentDepth < QUICK_SCAN_MAX_LEARNED_DEPTH && m_statistics.richness(directoryPath) > 0;
+}
+
+bool ScanWorker::budgetExhausted() {
+    if (!m_budgetExhausted && m_timeBudgetMs > 0 && m_scanTimer.elapsed() >= m_timeBudgetMs) {
+        qDebug() << "ScanWorker: Time budget of" << m_timeBudgetMs << "ms used up after" << m_foldersScannedCount << "folders.";
+        m_budgetExhausted = true;
     }
+    return m_budgetExhausted;
 }
 
-bool ScanWorker::checkForSoftudioProject(const QString& dirPath, ProjectInfo& projectInfo) {
-    QDir projectDir(dirPath);
-    QString originalFolderName = projectDir.dirName();
+int ScanWorker::directoryPriority(const QString& path, QStringView name, int depth) const {
+    int score = depth * DEPTH_PRIORITY_COST;
+    if (!m_statistics.isEmpty()) {
+        const double richness = m_statistics.richness(path);
+        if (richness > 0) score -= qMin(RICH_PRIORITY_BONUS_MAX, qRound(richness * RICH_PRIORITY_PER_HIT));
+        else if (m_statistics.isBarren(path)) score += BARREN_PRIORITY_PENALTY;
+    }
+    const QString lowerName = name.toString().toLower();
+    if (PRIORITY_WORKSPACE_NAMES.contains(lowerName)) score -= WORKSPACE_PRIORITY_BONUS;
+    else if (BULK_DIRECTORY_NAMES.contains(lowerName)) score += BULK_PRIORITY_PENALTY;
+    else if (lowerName.startsWith('.')) score += HIDDEN_PRIORITY_PENALTY;
+    return score;
+}
 
-    // Handle cases like "." or ".." path segments if dirPath is not absolute/cleaned
-    if (originalFolderName.isEmpty() || originalFolderName == "." || originalFolderName == "..") {
-         QFileInfo fi(dirPath);
-         originalFolderName = fi.fileName(); // More reliable for paths like "C:/MyProjects/ProjectA/."
-         if (originalFolderName.isEmpty()) originalFolderName = fi.dir().dirName(); // If path ends with slash
+QStringList ScanWorker::prioritySeedsFor(const QString& rootPath) const {
+    // Places where users keep projects, visited before the rest of the root.
+    const QString home = QDir::homePath();
+    QStringList candidates = {
+        home,
+        QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation),
+        QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)
+    };
+    for (const QString& name : PRIORITY_WORKSPACE_NAMES) {
+        candidates.append(home + '/' + name);
+        candidates.append(home + '/' + name.at(0).toUpper() + name.mid(1)); // "Projects", "Dev", ...
     }
-    
-    QString sanitizedFolderName = originalFolderName;
+
+    QStringList seeds;
+    for (const QString& candidate : std::as_const(candidates)) {
+        if (candidate.isEmpty()) continue;
+        const QString nativePath = QDir::toNativeSeparators(QDir::cleanPath(candidate));
+        if (nativePath == rootPath || seeds.contains(nativePath) || !isSameOrUnder(nativePath, rootPath)) continue;
+        if (QFileInfo(nativePath).isDir()) seeds.append(nativePath);
+    }
+    return seeds;
+}
+
+void ScanWorker::walkPrioritized() {
+    StartupTrace::Zone zone("Prioritized walk", "scan");
+    std::priority_queue<PrioritizedDirectory, std::vector<PrioritizedDirectory>, VisitLater> queue;
+    TraversalFrontier overflow(m_frontierMemoryLimit); // Drained once the queue runs dry
+    QSet<QString> seeds;
+    quint64 sequence = 0;
+
+    auto enqueue = [&](const QString& path, int depth, int priorityDepth) {
+        if (static_cast<int>(queue.size()) >= PRIORITY_QUEUE_LIMIT) {
+            overflow.push(path, depth); // Drained in stack order; the score no longer matters
+            return;
+        }
+        const DirectoryCandidate candidate(path);
+        queue.push({directoryPriority(path, candidate.name(), priorityDepth), sequence++, path, depth, priorityDepth});
+    };
+
+    // Seeds are scored as depth 0 so they compete with the roots themselves,
+    // but keep their real depth below the root for the statistics.
+    for (const QString& root : std::as_const(m_scanRoots)) {
+        const QString nativeRoot = QDir::toNativeSeparators(root);
+        for (const QString& seed : prioritySeedsFor(nativeRoot)) {
+            if (seeds.contains(seed)) continue;
+            seeds.insert(seed);
+            enqueue(seed, depthBelow(seed, nativeRoot), 0);
+        }
+    }
+    for (const QString& root : std::as_const(m_scanRoots)) enqueue(QDir::toNativeSeparators(root), 0, 0);
+
+    while (!m_stopRequested && !budgetExhausted()) {
+        QString path;
+        int depth = 0;
+        int priorityDepth = 0;
+        if (!queue.empty()) {
+            path = queue.top().path;
+            depth = queue.top().depth;
+            priorityDepth = queue.top().priorityDepth;
+            queue.pop();
+        } else {
+            TraversalFrontier::Entry entry;
+            if (!overflow.pop(entry)) break;
+            path = entry.path;
+            depth = entry.depth;
+            priorityDepth = entry.depth;
+        }
+
+        if (!visitDirectory(path, depth)) continue;
+
+        QDirIterator it(path, QDir::Dirs | QDir::NoDotAndDotDot | QDir::Readable | QDir::Hidden | QDir::System);
+        int listed = 0;
+        while (it.hasNext()) {
+            if (m_stopRequested || ((++listed & 0xFF) == 0 && budgetExhausted())) break;
+            const QFileInfo child = it.nextFileInfo();
+            if (!child.isDir() || child.isSymLink()) continue;
+            const QString childPath = QDir::toNativeSeparators(child.absoluteFilePath());
+            if (seeds.contains(childPath)) continue; // Already queued (or visited) as a seed
+            enqueue(childPath, depth + 1, priorityDepth + 1);
+        }
+    }
+
+    reportFrontierError(QDir::toNativeSeparators(m_scanRoots.join("; ")), overflow);
+    m_frontierRemaining = static_cast<qint64>(queue.size()) + overflow.size();
+    if (m_budgetExhausted) {
+        qDebug() << "ScanWorker: Budgeted scan stopped with" << m_frontierRemaining << "directories unvisited.";
+    }
+}
+
+void ScanWorker::reportFoundProject(const DirectoryCandidate& candidate) {
+    const PathId pathId = PathTree::shared().intern(candidate.path);
+    if (m_foundPathIds.contains(pathId)) return;
+    m_foundPathIds.insert(pathId);
+    // Heuristic finds (CMakeLists, .git, src/include/lib, ...) would make system
+    // trees like /usr/include look rich; only Softudio projects teach the walk.
+    if (candidate.isSoftudio()) m_statistics.recordHit(candidate.path, m_currentVisitDepth);
+
+    // Only real hits become a full ProjectInfo.
+    ProjectInfo projectInfo = candidate.toProjectInfo();
+    projectInfo.pathId = pathId;
+    m_foundProjectsList.append(projectInfo);
+    emit projectFound(projectInfo); // Let dialog know about raw find
+    if (candidate.isSoftudio()) emit validationRequested(projectInfo); // Request full validation
+}
+
+bool ScanWorker::checkForSoftudioProject(const QString& dirPath, DirectoryCandidate& candidate) {
+    QString sanitizedFolderName = candidate.name().toString();
     sanitizedFolderName.removeIf([](QChar c){ return !c.isLetterOrNumber() && c != '_'; });
 
     QDir nestedDir(dirPath);
@@ -283,7 +613,7 @@ bool ScanWorker::checkForSoftudioProject(const QString& dirPath, ProjectInfo& pr
 
     QFileInfo fileInfo(expectedFilePath);
     if (fileInfo.exists() && fileInfo.isFile() && fileInfo.isReadable()) {
-        projectInfo.name = originalFolderName; // Set initial name
+        candidate.type = ProjectType::SoftudioPotential;
         return true; 
     }
     return false;
@@ -292,59 +622,46 @@ bool ScanWorker::checkForSoftudioProject(const QString& dirPath, ProjectInfo& pr
 // ... (checkForHeuristicProjects and handleWalkError can remain similar to your existing refined versions, ensure they use HEURISTIC_FILES_MAP and HEURISTIC_DIRS_MAP) ...
 
 // Example of how checkForHeuristicProjects might look with QMap:
-void ScanWorker::checkForHeuristicProjects(const QString& dirPath, ProjectInfo& projectInfo) {
-    if (projectInfo.heuristicallyFound || projectInfo.isSoftudioProjectFlag) {
+void ScanWorker::checkForHeuristicProjects(const QString& dirPath, DirectoryCandidate& candidate) {
+    if (candidate.isProject()) {
         return; // Already identified
     }
 
     QDir dir(dirPath);
-    QString currentDirName = dir.dirName();
-    if (currentDirName.isEmpty() || currentDirName == "." || currentDirName == "..") {
-        QFileInfo fi(dirPath);
-        currentDirName = fi.fileName();
-        if(currentDirName.isEmpty()) currentDirName = fi.dir().dirName();
-    }
-
 
-    QMapIterator<QString, QString> fileIter(HEURISTIC_FILES_MAP);
+    QMapIterator<QString, ProjectType> fileIter(HEURISTIC_FILES_MAP);
     while (fileIter.hasNext()) {
         if (m_stopRequested) return;
         fileIter.next();
         const QString& heuristicPattern = fileIter.key();
-        const QString& heuristicType = fileIter.value();
+        const ProjectType heuristicType = fileIter.value();
 
         if (heuristicPattern.startsWith("*.")) { 
             QStringList nameFilters;
             nameFilters << heuristicPattern;
             if (!dir.entryList(nameFilters, QDir::Files | QDir::Hidden | QDir::System | QDir::Readable).isEmpty()) {
-                projectInfo.heuristicallyFound = true;
-                projectInfo.type = QString("heuristic_%1").arg(heuristicType);
-                projectInfo.name = currentDirName; 
+                candidate.type = heuristicType;
                 return; 
             }
         } else { 
             QFileInfo fileInfo(dir.filePath(heuristicPattern));
              if (fileInfo.exists() && (fileInfo.isFile() || (heuristicPattern == ".git" && fileInfo.isDir())) && fileInfo.isReadable() ) {
-                projectInfo.heuristicallyFound = true;
-                projectInfo.type = QString("heuristic_%1").arg(heuristicType);
-                projectInfo.name = currentDirName; 
+                candidate.type = heuristicType;
                 return; 
             }
         }
     }
 
-    QMapIterator<QString, QString> dirIter(HEURISTIC_DIRS_MAP);
+    QMapIterator<QString, ProjectType> dirIter(HEURISTIC_DIRS_MAP);
     while (dirIter.hasNext()) {
         if (m_stopRequested) return;
         dirIter.next();
         const QString& heuristicDirName = dirIter.key();
-        const QString& heuristicType = dirIter.value();
+        const ProjectType heuristicType = dirIter.value();
         
         QDir subDir(dir.filePath(heuristicDirName));
         if (subDir.exists() && subDir.isReadable()) { // Check readability of subdir as well
-            projectInfo.heuristicallyFound = true;
-            projectInfo.type = QString("heuristic_%1").arg(heuristicType); // e.g. heuristic_source_dir
-            projectInfo.name = currentDirName;
+            candidate.type = heuristicType;
             return; 
         }
     }
@@ -353,7 +670,16 @@ void ScanWorker::checkForHeuristicProjects(const QString& dirPath, ProjectInfo&
 void ScanWorker::handleWalkError(const QString& path, const QString& errorMsg) {
     // Only add if not already stopped, to avoid flooding errors during cancellation
     if (!m_stopRequested) {
-        m_scanErrors.append({QDir::toNativeSeparators(path), errorMsg});
-        qDebug() << "ScanWorker Error:" << path << "-" << errorMsg;
+        const QString nativePath = QDir::toNativeSeparators(path);
+        m_pendingErrors.append({nativePath, errorMsg}); // Interned, if at all, by the store that keeps it
+        // Only sampled errors are logged; a full-disk scan can report millions of them.
+        if (m_scanErrors.add(nativePath, errorMsg)) qDebug() << "ScanWorker Error:" << path << "-" << errorMsg;
+        if (m_pendingErrors.size() >= ERROR_BATCH_FLUSH_SIZE) flushPendingErrors();
     }
+}
+
+void ScanWorker::flushPendingErrors() {
+    if (m_pendingErrors.isEmpty()) return;
+    emit scanErrorsReported(m_pendingErrors);
+    m_pendingErrors.clear();
 }
\ No newline at end of file
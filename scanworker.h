@@ -9,9 +9,16 @@
 #include <QFileInfo>
 #include <QFileInfoList>
 #include <QList>
-#include "projectinfo.h"    
+#include <QSet>
+#include "projectinfo.h"
+#include "directorycandidate.h"
+#include "pathtree.h"
+#include "scanerrorstore.h"
+#include "traversalstatistics.h"
+#include "scanthrottle.h"
 
 class QTimer; // <<< Forward declaration
+class TraversalFrontier;
 
 class ScanWorker : public QObject {
     Q_OBJECT
@@ -20,6 +27,11 @@ public:
     explicit ScanWorker(QObject *parent = nullptr);
     ~ScanWorker() override;
 
+    void setFrontierMemoryLimit(qint64 bytes); // Call before doScan
+    void setTimeBudgetMs(qint64 ms);           // Budgeted scan only; call before doScan
+    void setStatisticsFile(const QString& settingsFileName); // INI file holding TraversalStatistics
+    void setBackgroundMode(bool enabled);      // Low priority and load-aware pacing; call before doScan
+
 public slots:
     void doScan(const QList<QString> &scanRoots, const QString &scanType);
     void stopScan();
@@ -31,16 +43,29 @@ signals:
     void scanProgress(const QString& pathMsg, int totalFoldersEst, int foldersScanned, double elapsedTime, bool isEstimating);
     void projectFound(const ProjectInfo &project);
     void validationRequested(const ProjectInfo &projectToValidate);
-    void scanFinished(const QList<ProjectInfo>& allFoundProjectsDuringScan, const QString& outcome, const QVariantMap& extra, const QList<QPair<QString, QString>>& errors);
+    void scanErrorsReported(const QList<ScanError>& errors); // Raw errors since the last report
+    void scanFinished(const QList<ProjectInfo>& allFoundProjectsDuringScan, const QString& outcome, const QVariantMap& extra, const ScanErrorStore& errors);
 
 
 private:
+    void collectInstantCandidates();
     void performScan();
     void countTotalFolders();
-    void processDirectory(const QString& directoryPath, int currentDepth);
+    void walkTree(const QString& rootPath);
+    void walkPrioritized();
+    bool visitDirectory(const QString& directoryPath, int currentDepth); // True to descend
+    bool shouldDescend(const QString& directoryPath, int currentDepth) const;
+    bool budgetExhausted();
+    int directoryPriority(const QString& path, QStringView name, int depth) const; // Lower is visited sooner
+    void loadTraversalStatistics();
+    void updateTraversalStatistics();
+    QStringList prioritySeedsFor(const QString& rootPath) const;
     void handleWalkError(const QString& path, const QString& errorMsg);
-    bool checkForSoftudioProject(const QString& dirPath, ProjectInfo& projectInfo);
-    void checkForHeuristicProjects(const QString& dirPath, ProjectInfo& projectInfo);
+    void reportFrontierError(const QString& rootPath, const TraversalFrontier& frontier);
+    void flushPendingErrors();
+    bool checkForSoftudioProject(const QString& dirPath, DirectoryCandidate& candidate);
+    void checkForHeuristicProjects(const QString& dirPath, DirectoryCandidate& candidate);
+    void reportFoundProject(const DirectoryCandidate& candidate);
 
 
     QList<QString> m_scanRoots;
@@ -51,19 +76,60 @@ private:
     qint64 m_foldersScannedCount;
     QElapsedTimer m_scanTimer;
     QList<ProjectInfo> m_foundProjectsList;
-    QList<QPair<QString, QString>> m_scanErrors;
+    QSet<PathId> m_foundPathIds;    // Dedupe by interned path instead of string compares
+    ScanErrorStore m_scanErrors;
+    QList<ScanError> m_pendingErrors; // Not yet sent through scanErrorsReported
 
     QString m_currentScanRootForProgress;
     QString m_lastProcessedPathForPeriodicEmit; // <<< For periodic emit
     int m_currentScanRootIndex;
     int m_totalScanRoots;
     bool m_isCurrentlyEstimatingForPeriodicEmit; // <<< For periodic emit
+    qint64 m_frontierMemoryLimit;
+    qint64 m_timeBudgetMs;
+    bool m_budgetExhausted;
+    qint64 m_frontierRemaining;     // Directories left unvisited when the budget ran out
+    qint64 m_frontierLost;          // Directories dropped by a failed frontier spill read
+
+    QString m_statisticsFile;
+    TraversalStatistics m_statistics;
+    int m_quickScanDepthLimit;      // QUICK_SCAN_DEPTH_LIMIT, possibly raised by past hit depths
+    int m_currentVisitDepth;
+    QStringList m_shallowVisited;   // Directories at depth 1..BARREN_TRACK_DEPTH, for barren detection
+
+    bool m_backgroundMode;
+    ScanThrottle m_throttle;
 
     QTimer *m_progressUpdateTimer; // <<< Added QTimer
 
     const QString SCAN_TYPE_QUICK = "Quick Scan (Faster, checks top levels)";
     const QString SCAN_TYPE_DEEP = "Deep Scan (Slower, checks all subfolders)";
+    const QString SCAN_TYPE_BUDGETED = "Budgeted Scan (Best results first, time limited)";
     const int QUICK_SCAN_DEPTH_LIMIT = 3;
+    const int QUICK_SCAN_MAX_LEARNED_DEPTH = 6; // Quick Scan never goes deeper, whatever the statistics say
+    const int BARREN_TRACK_DEPTH = 2;
+    const int MAX_SHALLOW_TRACKED = 4096;
+
+    // Budgeted scan: directories are visited lowest score first (score grows by
+    // DEPTH_PRIORITY_COST per level), likely workspace names are pulled forward
+    // and bulky tool/cache directories pushed back.
+    const int DEPTH_PRIORITY_COST = 10;
+    const int WORKSPACE_PRIORITY_BONUS = 15;
+    const int HIDDEN_PRIORITY_PENALTY = 20;
+    const int BULK_PRIORITY_PENALTY = 40;
+    const int RICH_PRIORITY_PER_HIT = 5;
+    const int RICH_PRIORITY_BONUS_MAX = 30;
+    const int BARREN_PRIORITY_PENALTY = 50;
+    const int PRIORITY_QUEUE_LIMIT = 100000; // Further entries go to a spillable overflow frontier
+    const QStringList PRIORITY_WORKSPACE_NAMES = {
+        "workspace", "workspaces", "projects", "dev", "src", "source", "repos", "code", "git", "softudio"
+    };
+    const QStringList BULK_DIRECTORY_NAMES = {
+        "node_modules", "appdata", "library", "windows", "program files", "program files (x86)",
+        "programdata", "proc", "sys", "usr", "var", "build", "dist", "target", "vendor", "$recycle.bin"
+    };
+    const int ERROR_BATCH_FLUSH_SIZE = 500;
+    const int CHILD_PUSH_CHUNK = 4096; // Children held back at once so a chunk pops in listing order
 
     const QString SOFTUDIO_FILE_EXTENSION = ".softudio";
     const QString SOFTUDIO_FILE_SIGNATURE = "SOFTUDIO_PROJECT_FILE_V1.0";
@@ -75,16 +141,16 @@ private:
     };
 
 
-    const QMap<QString, QString> HEURISTIC_FILES_MAP = { // Using QMap for type association
-        {"CMakeLists.txt", "cmake"}, {"package.json", "npm_yarn"}, {".git", "git_repo"},
-        {".sln", "vs_solution"}, {".uproject", "unreal"}, {"*.csproj", "csharp_proj"},
-        {"Makefile", "make"}, {"pom.xml", "maven"}, {"build.gradle", "gradle"},
-        {"setup.py", "python_setup"}
+    const QMap<QString, ProjectType> HEURISTIC_FILES_MAP = { // Using QMap for type association
+        {"CMakeLists.txt", ProjectType::Cmake}, {"package.json", ProjectType::NpmYarn}, {".git", ProjectType::GitRepo},
+        {".sln", ProjectType::VsSolution}, {".uproject", ProjectType::Unreal}, {"*.csproj", ProjectType::CsharpProject},
+        {"Makefile", ProjectType::Make}, {"pom.xml", ProjectType::Maven}, {"build.gradle", ProjectType::Gradle},
+        {"setup.py", ProjectType::PythonSetup}
     };
-    const QMap<QString, QString> HEURISTIC_DIRS_MAP = { // Using QMap for type association
-        {"src", "source_dir"}, {"include", "include_dir"}, {"lib", "library_dir"},
-        {"source", "source_dir"}, {"Sources", "source_dir"}, {"Source", "source_dir"},
-        {"includes", "include_dir"}, {"headers", "include_dir"}
+    const QMap<QString, ProjectType> HEURISTIC_DIRS_MAP = { // Using QMap for type association
+        {"src", ProjectType::SourceDir}, {"include", ProjectType::IncludeDir}, {"lib", ProjectType::LibraryDir},
+        {"source", ProjectType::SourceDir}, {"Sources", ProjectType::SourceDir}, {"Source", ProjectType::SourceDir},
+        {"includes", ProjectType::IncludeDir}, {"headers", ProjectType::IncludeDir}
     };
 };
 
@@ -2,6 +2,7 @@
 #define SPLASH_CONSTANTS_H
 
 #include <QString>
+#include <QStringList>
 #include <QColor>
 #include <QLinearGradient> // Included for completeness, though gradient setup is complex for a simple const
 
@@ -11,6 +12,13 @@ const QString ICON_PATH_REL = QStringLiteral(".engine/Graphics/PNG/Core/UIElemen
 const QString TEMPLATE_IMAGE_PATH_REL = QStringLiteral(".engine/Graphics/PNG/UI/ProjectManagerWindowGUI/Templates");
 const QString APP_ICON_PATH_PRIMARY_REL = QStringLiteral(".engine/Graphics/PNG/Core/Logo/Logo_32x32.ico");
 const QString APP_ICON_PATH_FALLBACK_REL = QStringLiteral("Logo_32x32.ico");
+const QString PROJECTS_FILE_NAME = QStringLiteral("projects.json"); // Next to the executable
+const QString STAR_ICON_FILE = QStringLiteral("star.png");         // In ICON_PATH_REL
+const QString STAR_OUTLINE_ICON_FILE = QStringLiteral("star_outline.png");
+const QStringList TEMPLATE_IMAGE_FILES = {                          // In TEMPLATE_IMAGE_PATH_REL
+    QStringLiteral("BlankTemplate.jpg"), QStringLiteral("UIExample.jpg"),
+    QStringLiteral("WebappExample.jpg"), QStringLiteral("BuildExample.jpg")
+};
 
 
 // --- Text Shine Animation Constants (for AnimatedLoadingLabel) ---
@@ -40,7 +48,7 @@ const QString APP_NAME = QStringLiteral("SOFTUDIO");
 const QString ORG_NAME = QStringLiteral("NXTLVLTECH");
 
 // --- Splash Screen Behavior ---
-const int SPLASH_DURATION_AFTER_LOAD_MS = 500; // As used in your splashscreen.py __main__
+const int SPLASH_MINIMUM_DISPLAY_MS = 1000; // Floor on how long the splash shows; loading time counts toward it
 
 // Helper function to construct the exit button gradient, as it's an object
 // This could be placed in a utility header or with ShiningButton class.
@@ -3,6 +3,9 @@
 #include "animatedloadinglabel.h"
 #include "shiningbutton.h"
 #include "loadingworker.h"
+#include "decodedimagecache.h"
+#include "startuptrace.h"
+#include "startupprefetcher.h"
 
 #include <QApplication>
 #include <QVBoxLayout>
@@ -21,9 +24,9 @@
 #include <QThread>
 #include <QCloseEvent>
 
-SplashScreen::SplashScreen(int splashDurationAfterLoadMs, QWidget *parent)
+SplashScreen::SplashScreen(int minimumDisplayMs, QWidget *parent)
     : QWidget(parent),
-      m_splashDurationAfterLoadMs(splashDurationAfterLoadMs),
+      m_minimumDisplayMs(minimumDisplayMs),
       m_loadSuccessful(false),
       m_loadingFileLabel(nullptr),
       m_loadingProgressBar(nullptr),
@@ -31,29 +34,32 @@ SplashScreen::SplashScreen(int splashDurationAfterLoadMs, QWidget *parent)
       m_loadingContainer(nullptr),
       m_mainLayout(nullptr),
       m_loadingLayout(nullptr),
-      m_initialDelayTimer(new QTimer(this)),
+      m_exitButtonTimer(new QTimer(this)),
       m_thread(nullptr),
-      m_worker(nullptr),
-      m_totalProgressTasks(0)
+      m_worker(nullptr)
 {
+    // Only project data needs the project manager; the assets load alongside.
     m_loadingTasks = {
-        { "Importing core modules...", "Project Manager UI", "_task_import_projectmanager", "importing the main application module" },
-        { "Loading user preferences...", "Project History & Settings", "_task_load_project_data", "loading project data" },
-        { "Loading UI assets...", "Icons", "_task_load_icons", "loading UI icons" },
-        { "Loading UI assets...", "Template Images", "_task_load_template_images", "loading template images" },
-        { "Finalizing...", "", "", "" },
-        { "Ready.", "", "", "" }
+        { "Importing core modules...", "Project Manager UI", LoadingTask::ImportProjectManager, "importing the main application module", {} },
+        { "Loading user preferences...", "Project History & Settings", LoadingTask::LoadProjectData, "loading project data", { LoadingTask::ImportProjectManager } },
+        { "Loading UI assets...", "Icons", LoadingTask::LoadIcons, "loading UI icons", {} },
+        { "Loading UI assets...", "Template Images", LoadingTask::LoadTemplateImages, "loading template images", {} },
+        { "Finalizing...", "", LoadingTask::None, "", {} },
+        { "Ready.", "", LoadingTask::None, "", {} }
     };
 
-    for(const auto& task : m_loadingTasks) {
-        if(!task.methodName.isEmpty()) {
-            m_totalProgressTasks++;
-        }
-    }
-
     setup_icon();
     
-    m_backgroundPixmap.load(_get_asset_path(BACKGROUND_IMAGE_PATH));
+    StartupTrace::Zone backgroundZone("Splash background");
+    const QString backgroundPath = _get_asset_path(BACKGROUND_IMAGE_PATH);
+    QImage backgroundImage = DecodedImageCache::shared().find(backgroundPath, QSize()); // Drawn at its own size
+    QByteArray backgroundBytes;
+    const bool backgroundPrefetched = backgroundImage.isNull() && StartupPrefetcher::take(backgroundPath, backgroundBytes);
+    if (backgroundImage.isNull() && (backgroundPrefetched ? backgroundImage.loadFromData(backgroundBytes) : backgroundImage.load(backgroundPath))) {
+        DecodedImageCache::shared().insert(backgroundPath, QSize(), backgroundImage); // Saved by the loading worker
+    }
+    m_backgroundPixmap = QPixmap::fromImage(backgroundImage);
+    backgroundZone.end();
     if (m_backgroundPixmap.isNull()) {
         qWarning() << "Warning: Could not load background image from" << _get_asset_path(BACKGROUND_IMAGE_PATH) << ". Using fallback color.";
         setFixedSize(600, 400);
@@ -75,9 +81,13 @@ SplashScreen::SplashScreen(int splashDurationAfterLoadMs, QWidget *parent)
 
     setup_ui();
 
-    m_initialDelayTimer->setSingleShot(true);
-    connect(m_initialDelayTimer, &QTimer::timeout, this, &SplashScreen::start_actual_loading);
-    m_initialDelayTimer->start(EXIT_BUTTON_VISIBLE_DURATION_MS);
+    // Loading starts right away; the exit button stays up alongside it for
+    // its usual time, and the minimum display time only acts as a floor.
+    m_displayTimer.start();
+    m_exitButtonTimer->setSingleShot(true);
+    connect(m_exitButtonTimer, &QTimer::timeout, this, [this]() { if (m_exitButton) m_exitButton->hide(); });
+    m_exitButtonTimer->start(EXIT_BUTTON_VISIBLE_DURATION_MS);
+    start_actual_loading();
 }
 
 SplashScreen::~SplashScreen()
@@ -129,7 +139,7 @@ void SplashScreen::setup_ui()
     m_mainLayout->addWidget(m_loadingContainer);
 
     m_loadingProgressBar = new QProgressBar(this);
-    m_loadingProgressBar->setRange(0, m_totalProgressTasks);
+    m_loadingProgressBar->setRange(0, LoadingWorker::PROGRESS_MAXIMUM);
     m_loadingProgressBar->setValue(0);
     m_loadingProgressBar->setTextVisible(false);
     m_loadingProgressBar->hide();
@@ -147,7 +157,6 @@ void SplashScreen::setup_ui()
 
 void SplashScreen::start_actual_loading()
 {
-    if (m_exitButton) m_exitButton->hide();
     if (m_loadingFileLabel) m_loadingFileLabel->show();
     if (m_loadingProgressBar) m_loadingProgressBar->show();
 
@@ -186,7 +195,7 @@ void SplashScreen::update_progress(int value)
 
 void SplashScreen::handle_loading_complete(
     const QString &main_window_class_placeholder,
-    const QVariantMap &project_data,
+    const ProjectStorePtr &project_store,
     const QVariantMap &images)
 {
     qDebug() << "Worker finished successfully in SplashScreen.";
@@ -195,10 +204,20 @@ void SplashScreen::handle_loading_complete(
         m_loadingFileLabel->stop_animation();
         m_loadingFileLabel->setText(tr("Ready."));
     }
-    if (m_loadingProgressBar) m_loadingProgressBar->setValue(m_totalProgressTasks);
+    if (m_loadingProgressBar) m_loadingProgressBar->setValue(LoadingWorker::PROGRESS_MAXIMUM);
+
+    StartupTrace::Zone pixmapZone("Convert loaded images");
+    // The worker decodes QImages; pixmaps may only be made here, on the GUI thread.
+    QVariantMap pixmaps;
+    for (auto it = images.cbegin(); it != images.cend(); ++it) {
+        pixmaps.insert(it.key(), QVariant::fromValue(QPixmap::fromImage(it.value().value<QImage>())));
+    }
+    pixmapZone.end();
 
-    QTimer::singleShot(m_splashDurationAfterLoadMs, this, [this, main_window_class_placeholder, project_data, images]() {
-        _finish_and_close(main_window_class_placeholder, project_data, images);
+    const qint64 remainingMs = qMax<qint64>(0, m_minimumDisplayMs - m_displayTimer.elapsed());
+    qDebug() << "Loading took" << m_displayTimer.elapsed() << "ms; keeping the splash up" << remainingMs << "ms more.";
+    QTimer::singleShot(remainingMs, this, [this, main_window_class_placeholder, project_store, pixmaps]() {
+        _finish_and_close(main_window_class_placeholder, project_store, pixmaps);
     });
 }
 
@@ -236,12 +255,12 @@ void SplashScreen::_cleanup_thread()
 
 void SplashScreen::_finish_and_close(
     const QString &main_window_class_placeholder,
-    const QVariantMap &project_data,
+    const ProjectStorePtr &project_store,
     const QVariantMap &images)
 {
     if (m_loadSuccessful) {
         qDebug() << "Emitting loading_finished signal from SplashScreen.";
-        emit loading_finished(main_window_class_placeholder, project_data, images);
+        emit loading_finished(main_window_class_placeholder, project_store, images);
     }
     close();
 }
@@ -303,7 +322,7 @@ void SplashScreen::showEvent(QShowEvent *event)
 void SplashScreen::closeEvent(QCloseEvent *event)
 {
     qDebug() << "SplashScreen closeEvent called.";
-    if(m_initialDelayTimer) m_initialDelayTimer->stop();
+    if(m_exitButtonTimer) m_exitButtonTimer->stop();
     _cleanup_thread();
     if(m_loadingFileLabel) m_loadingFileLabel->stop_animation();
     if(m_exitButton) m_exitButton->stop_animation();
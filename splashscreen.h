@@ -5,6 +5,8 @@
 #include <QPixmap>
 #include <QList>
 #include <QVariantMap>
+#include <QElapsedTimer>
+#include "projectstore.h"
 
 class QVBoxLayout;
 class AnimatedLoadingLabel;
@@ -24,12 +26,12 @@ class SplashScreen : public QWidget
     Q_OBJECT
 
 public:
-    explicit SplashScreen(int splashDurationAfterLoadMs = 1000, QWidget *parent = nullptr);
+    explicit SplashScreen(int minimumDisplayMs = 1000, QWidget *parent = nullptr); // See SPLASH_MINIMUM_DISPLAY_MS
     ~SplashScreen() override;
 
 signals:
     void loading_finished(const QString &main_window_class_placeholder,
-                          const QVariantMap &project_data,
+                          const ProjectStorePtr &project_store,
                           const QVariantMap &images);
     void loading_failed(const QString &error_msg);
 
@@ -44,12 +46,12 @@ private slots:
     void update_status_text(const QString &user_msg, const QString &detail_msg);
     void update_progress(int value);
     void handle_loading_complete(const QString &main_window_class_placeholder,
-                                 const QVariantMap &project_data,
+                                 const ProjectStorePtr &project_store,
                                  const QVariantMap &images);
     void handle_loading_error(const QString &error_context, const QString &error_message);
     void _cleanup_thread();
     void _finish_and_close(const QString &main_window_class_placeholder,
-                           const QVariantMap &project_data,
+                           const ProjectStorePtr &project_store,
                            const QVariantMap &images);
 
 private:
@@ -57,7 +59,7 @@ private:
     void setup_icon();
     QString _get_asset_path(const QString &relative_path) const;
 
-    int m_splashDurationAfterLoadMs;
+    int m_minimumDisplayMs;          // Floor from construction to close, not added after loading
     bool m_loadSuccessful;
 
     QPixmap m_backgroundPixmap;
@@ -68,12 +70,12 @@ private:
     QVBoxLayout *m_mainLayout;
     QVBoxLayout *m_loadingLayout;
 
-    QTimer *m_initialDelayTimer;
+    QTimer *m_exitButtonTimer;
+    QElapsedTimer m_displayTimer;
 
     QThread *m_thread;
     LoadingWorker *m_worker;
     QList<TaskDefinition> m_loadingTasks;
-    int m_totalProgressTasks;
 };
 
 #endif // SPLASHSCREEN_H
\ No newline at end of file
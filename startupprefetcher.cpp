@@ -0,0 +1,172 @@
+#include "startupprefetcher.h"
+#include "splash_constants.h"
+#include "startuptrace.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QDeadlineTimer>
+#include <QDebug>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#endif
+
+namespace {
+struct PrefetchedFile {
+    QByteArray contents;
+    bool done = false;
+    bool ok = false;
+};
+
+struct PrefetchState {
+    QMutex mutex;               // Guards files and open
+    QWaitCondition fileRead;
+    QHash<QString, PrefetchedFile> files;
+    QStringList order;          // Read in this order; not guarded, fixed before the threads start
+    std::atomic<int> next{0};
+    std::atomic_flag hinted = ATOMIC_FLAG_INIT;
+    std::vector<std::thread> readers;
+    bool open = false;
+
+    ~PrefetchState() {
+        for (std::thread &reader : readers) {
+            if (reader.joinable()) reader.join(); // Exit paths that never called discard()
+        }
+    }
+};
+
+PrefetchState &state() {
+    static PrefetchState prefetchState;
+    return prefetchState;
+}
+}
+
+QString StartupPrefetcher::executableDirectory() {
+    // QCoreApplication::applicationDirPath() needs the application object,
+    // which does not exist yet; ask the OS the same way it does.
+#if defined(Q_OS_LINUX)
+    return QFileInfo(QFileInfo(QStringLiteral("/proc/self/exe")).canonicalFilePath()).path();
+#elif defined(Q_OS_WIN)
+    wchar_t buffer[MAX_PATH];
+    const DWORD length = GetModuleFileNameW(nullptr, buffer, MAX_PATH);
+    if (length == 0 || length >= MAX_PATH) return QString();
+    return QFileInfo(QDir::fromNativeSeparators(QString::fromWCharArray(buffer, int(length)))).path();
+#else
+    return QString();
+#endif
+}
+
+QStringList StartupPrefetcher::startupFiles(const QString &baseDirectory) {
+    // Same paths the loader and splash build from applicationDirPath().
+    QStringList files;
+    files << QDir::cleanPath(baseDirectory + "/" + PROJECTS_FILE_NAME);
+    files << QDir::cleanPath(baseDirectory + QDir::separator() + BACKGROUND_IMAGE_PATH);
+    files << QDir::cleanPath(baseDirectory + "/" + ICON_PATH_REL + "/" + STAR_ICON_FILE);
+    files << QDir::cleanPath(baseDirectory + "/" + ICON_PATH_REL + "/" + STAR_OUTLINE_ICON_FILE);
+    for (const QString &templateFile : TEMPLATE_IMAGE_FILES) {
+        files << QDir::cleanPath(baseDirectory + "/" + TEMPLATE_IMAGE_PATH_REL + "/" + templateFile);
+    }
+    return files;
+}
+
+void StartupPrefetcher::start() {
+    PrefetchState &prefetch = state();
+    if (prefetch.open || !prefetch.readers.empty()) return;
+    const QString baseDirectory = executableDirectory();
+    if (baseDirectory.isEmpty()) return;
+
+    prefetch.order = startupFiles(baseDirectory);
+    {
+        QMutexLocker locker(&prefetch.mutex);
+        for (const QString &path : prefetch.order) prefetch.files.insert(path, PrefetchedFile());
+        prefetch.open = true;
+    }
+    for (int i = 0; i < READER_THREADS; ++i) prefetch.readers.emplace_back(&StartupPrefetcher::readFiles);
+}
+
+void StartupPrefetcher::readFiles() {
+    PrefetchState &prefetch = state();
+
+#if defined(Q_OS_LINUX)
+    // One reader queues readahead for every file before anything blocks on a read.
+    if (!prefetch.hinted.test_and_set()) {
+        StartupTrace::Zone zone("Prefetch hints", "loader");
+        for (const QString &path : prefetch.order) {
+            const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) continue;
+            posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+            ::close(fd);
+        }
+    }
+#endif
+
+    for (int index = prefetch.next++; index < int(prefetch.order.size()); index = prefetch.next++) {
+        const QString &path = prefetch.order.at(index);
+        StartupTrace::Zone zone("Prefetch file", path, "loader");
+        PrefetchedFile result;
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly)) {
+            result.contents = file.readAll();
+            result.ok = file.error() == QFileDevice::NoError;
+        }
+        result.done = true;
+
+        QMutexLocker locker(&prefetch.mutex);
+        if (!prefetch.open) return; // Discarded meanwhile
+        prefetch.files.insert(path, result);
+        prefetch.fileRead.wakeAll();
+    }
+}
+
+bool StartupPrefetcher::take(const QString &filePath, QByteArray &contents) {
+    PrefetchState &prefetch = state();
+    const QString path = QDir::cleanPath(filePath);
+    QDeadlineTimer deadline(TAKE_TIMEOUT_MS);
+    QMutexLocker locker(&prefetch.mutex);
+    while (prefetch.open) {
+        auto it = prefetch.files.find(path);
+        if (it == prefetch.files.end()) return false; // Not a prefetched file, or already taken
+        if (it->done) {
+            const bool ok = it->ok;
+            if (ok) contents = std::move(it->contents);
+            prefetch.files.erase(it);
+            return ok;
+        }
+        if (!prefetch.fileRead.wait(&prefetch.mutex, deadline)) {
+            qDebug() << "StartupPrefetcher: Gave up waiting for" << path;
+            return false;
+        }
+    }
+    return false;
+}
+
+void StartupPrefetcher::discard() {
+    PrefetchState &prefetch = state();
+    int unclaimed = 0;
+    {
+        QMutexLocker locker(&prefetch.mutex);
+        if (!prefetch.open) return;
+        prefetch.open = false;
+        for (const PrefetchedFile &file : std::as_const(prefetch.files)) {
+            if (file.done && file.ok) ++unclaimed;
+        }
+        prefetch.files.clear();
+        prefetch.fileRead.wakeAll();
+    }
+    for (std::thread &reader : prefetch.readers) {
+        if (reader.joinable()) reader.join();
+    }
+    if (unclaimed > 0) qDebug() << "StartupPrefetcher: Dropped" << unclaimed << "unclaimed buffer(s).";
+}
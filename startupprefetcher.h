@@ -0,0 +1,30 @@
+#ifndef STARTUPPREFETCHER_H
+#define STARTUPPREFETCHER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+// Reads the files the loader needs (projects.json, splash and project
+// manager images) on plain background threads, started from main() before
+// QApplication exists, so disk latency overlaps with Qt's platform setup.
+// On Linux every file is first hinted with posix_fadvise(WILLNEED) so the
+// kernel reads ahead for all of them at once. Consumers ask for a file with
+// take(); anything not prefetched, or not read in time, is simply read by
+// the caller as before.
+class StartupPrefetcher {
+public:
+    static void start();            // Returns at once; safe before QApplication
+    static bool take(const QString &filePath, QByteArray &contents); // Hands over the buffer, waiting for it if needed
+    static void discard();          // Joins the readers and frees unclaimed buffers; take() then always fails
+
+    static const int READER_THREADS = 2;
+    static const int TAKE_TIMEOUT_MS = 2000;
+
+private:
+    static QString executableDirectory();
+    static QStringList startupFiles(const QString &baseDirectory);
+    static void readFiles();
+};
+
+#endif // STARTUPPREFETCHER_H
@@ -0,0 +1,166 @@
+#include "startuptrace.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QDebug>
+#include <vector>
+#include <cstring>
+
+namespace {
+struct TraceEvent {
+    const char *name;           // String literals only; never copied
+    const char *category;
+    char phase;                 // 'X' complete, 'i' instant
+    qint64 startNs;
+    qint64 durationNs;
+    int threadId;
+    QString detail;
+};
+
+struct TraceState {
+    QMutex mutex;               // Guards everything below
+    QElapsedTimer clock;
+    QString fileName;
+    std::vector<TraceEvent> events;
+    QList<QString> threadNames; // Index is thread id - 1
+    qint64 droppedEvents = 0;
+};
+
+TraceState &state() {
+    static TraceState traceState;
+    return traceState;
+}
+
+thread_local int t_threadId = 0;
+
+// Small stable ids read better in trace viewers than native thread handles.
+int currentThreadId(TraceState &trace) {
+    if (t_threadId == 0) {
+        QString name = QThread::currentThread() ? QThread::currentThread()->objectName() : QString();
+        trace.threadNames.append(name);
+        t_threadId = trace.threadNames.size();
+        if (name.isEmpty()) trace.threadNames.last() = QString("Thread %1").arg(t_threadId);
+    }
+    return t_threadId;
+}
+}
+
+std::atomic<bool> StartupTrace::s_enabled(false);
+
+void StartupTrace::initialize(int argc, char *argv[]) {
+    QString fileName;
+    bool enabled = false;
+    const QString fromEnvironment = qEnvironmentVariable("SOFTUDIO_TRACE");
+    if (!fromEnvironment.isEmpty() && fromEnvironment != QLatin1String("0")) {
+        enabled = true;
+        if (fromEnvironment != QLatin1String("1")) fileName = fromEnvironment;
+    }
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--trace") == 0) {
+            enabled = true;
+        } else if (std::strncmp(argv[i], "--trace=", 8) == 0) {
+            enabled = true;
+            fileName = QString::fromLocal8Bit(argv[i] + 8);
+        }
+    }
+    if (!enabled) return;
+
+    TraceState &trace = state();
+    QMutexLocker locker(&trace.mutex);
+    trace.clock.start();
+    trace.fileName = fileName.isEmpty()
+        ? QDir(QDir::tempPath()).filePath(QString("softudio-trace-%1.json").arg(QCoreApplication::applicationPid()))
+        : fileName;
+    trace.events.reserve(4096);
+    currentThreadId(trace);
+    trace.threadNames[t_threadId - 1] = QStringLiteral("Main");
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+qint64 StartupTrace::nowNs() {
+    return state().clock.nsecsElapsed();
+}
+
+void StartupTrace::record(char phase, const char *name, const char *category, qint64 startNs, qint64 durationNs, const QString &detail) {
+    TraceState &trace = state();
+    QMutexLocker locker(&trace.mutex);
+    if (trace.events.size() >= size_t(MAX_EVENTS)) {
+        ++trace.droppedEvents;
+        return;
+    }
+    trace.events.push_back({ name, category, phase, startNs, durationNs, currentThreadId(trace), detail });
+}
+
+void StartupTrace::instant(const char *name, const char *category) {
+    if (!isEnabled()) return;
+    record('i', name, category, nowNs(), 0, QString());
+}
+
+StartupTrace::Zone::Zone(const char *name, const char *category)
+    : m_name(name),
+      m_category(category),
+      m_startNs(StartupTrace::isEnabled() ? StartupTrace::nowNs() : -1)
+{
+}
+
+StartupTrace::Zone::Zone(const char *name, const QString &detail, const char *category)
+    : m_name(name),
+      m_category(category),
+      m_startNs(StartupTrace::isEnabled() ? StartupTrace::nowNs() : -1)
+{
+    if (m_startNs >= 0) m_detail = detail; // Not even a reference count bump when off
+}
+
+StartupTrace::Zone::~Zone() {
+    end();
+}
+
+void StartupTrace::Zone::end() {
+    if (m_startNs < 0) return;
+    StartupTrace::record('X', m_name, m_category, m_startNs, StartupTrace::nowNs() - m_startNs, m_detail);
+    m_startNs = -1;
+}
+
+bool StartupTrace::write() {
+    if (!isEnabled()) return false;
+    TraceState &trace = state();
+    QMutexLocker locker(&trace.mutex);
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+    QJsonObject processName{{"ph", "M"}, {"name", "process_name"}, {"pid", pid}, {"tid", 0},
+                            {"args", QJsonObject{{"name", "SOFTUDIO"}}}};
+    events.append(processName);
+    for (int i = 0; i < trace.threadNames.size(); ++i) {
+        events.append(QJsonObject{{"ph", "M"}, {"name", "thread_name"}, {"pid", pid}, {"tid", i + 1},
+                                  {"args", QJsonObject{{"name", trace.threadNames.at(i)}}}});
+    }
+    for (const TraceEvent &event : trace.events) {
+        QJsonObject object{{"name", QString::fromLatin1(event.name)}, {"cat", QString::fromLatin1(event.category)},
+                           {"ph", QString(QLatin1Char(event.phase))}, {"pid", pid}, {"tid", event.threadId},
+                           {"ts", event.startNs / 1000.0}}; // Microseconds
+        if (event.phase == 'X') object.insert("dur", event.durationNs / 1000.0);
+        else object.insert("s", "t");                                   // Instant scoped to its thread
+        if (!event.detail.isEmpty()) object.insert("args", QJsonObject{{"detail", event.detail}});
+        events.append(object);
+    }
+
+    QFile file(trace.fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "StartupTrace: Cannot write" << trace.fileName << ":" << file.errorString();
+        return false;
+    }
+    QJsonObject root{{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+    if (trace.droppedEvents > 0) root.insert("otherData", QJsonObject{{"droppedEvents", trace.droppedEvents}});
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    qInfo().noquote() << QString("StartupTrace: Wrote %1 event(s) to %2").arg(trace.events.size()).arg(trace.fileName);
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QString>
+#include <atomic>
+
+// Opt-in trace of where launch and scan time goes, written as Chrome trace
+// event JSON (chrome://tracing, ui.perfetto.dev). Enabled by SOFTUDIO_TRACE
+// (1 or an output file) or by --trace / --trace=<file> on the command line;
+// otherwise a zone costs one relaxed atomic load. Zones may be opened on any
+// thread; each thread shows up as its own track.
+class StartupTrace {
+public:
+    class Zone {
+    public:
+        explicit Zone(const char *name, const char *category = "startup");
+        Zone(const char *name, const QString &detail, const char *category);
+        ~Zone();
+        void end();                 // Closes the zone before the end of its scope
+
+        Zone(const Zone &) = delete;
+        Zone &operator=(const Zone &) = delete;
+
+    private:
+        const char *m_name;
+        const char *m_category;
+        QString m_detail;
+        qint64 m_startNs;           // -1 while tracing is off
+    };
+
+    static void initialize(int argc, char *argv[]); // First thing in main(); the calling thread is "Main"
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static void instant(const char *name, const char *category = "startup");
+    static bool write();            // Writes everything recorded so far to the trace file
+
+    static const int MAX_EVENTS = 200000; // Later events are counted but dropped
+
+private:
+    static qint64 nowNs();
+    static void record(char phase, const char *name, const char *category, qint64 startNs, qint64 durationNs, const QString &detail);
+
+    static std::atomic<bool> s_enabled;
+};
+
+#endif // STARTUPTRACE_H
@@ -0,0 +1,117 @@
+#include "traversalfrontier.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QDebug>
+
+const qint64 TraversalFrontier::DEFAULT_MEMORY_LIMIT_BYTES;
+const qint64 TraversalFrontier::MIN_MEMORY_LIMIT_BYTES;
+
+TraversalFrontier::TraversalFrontier(qint64 memoryLimitBytes)
+    : m_memoryLimit(qMax(memoryLimitBytes, MIN_MEMORY_LIMIT_BYTES)),
+      m_memoryBytes(0),
+      m_spilledCount(0),
+      m_lostCount(0),
+      m_spillCount(0)
+{
+}
+
+TraversalFrontier::~TraversalFrontier() = default;
+
+qint64 TraversalFrontier::entryCost(const Entry &entry) {
+    // String payload plus the list slot and string header; close enough to bound real usage.
+    return qint64(sizeof(Entry)) + 32 + entry.path.size() * qint64(sizeof(QChar));
+}
+
+void TraversalFrontier::push(const QString &path, int depth) {
+    Entry entry{path, depth};
+    m_memoryBytes += entryCost(entry);
+    m_entries.append(std::move(entry));
+    if (m_memoryBytes > m_memoryLimit && m_entries.size() > 1) spill();
+}
+
+bool TraversalFrontier::pop(Entry &entry) {
+    // A damaged segment may yield nothing; go on with the one below it.
+    while (m_entries.isEmpty()) {
+        if (!reload()) return false;
+    }
+    entry = m_entries.takeLast();
+    m_memoryBytes -= entryCost(entry);
+    return true;
+}
+
+void TraversalFrontier::clear() {
+    m_entries.clear();
+    m_memoryBytes = 0;
+    m_segmentOffsets.clear();
+    m_segmentCounts.clear();
+    m_spilledCount = 0;
+    m_lostCount = 0;
+    m_spillFile.reset(); // Removes the temporary file
+    m_error.clear();
+}
+
+bool TraversalFrontier::spill() {
+    if (hasError()) return false; // Keep going in memory rather than lose entries
+
+    if (!m_spillFile) {
+        m_spillFile.reset(new QTemporaryFile(QDir::tempPath() + QStringLiteral("/softudio-scan-frontier-XXXXXX")));
+        if (!m_spillFile->open()) {
+            m_error = m_spillFile->errorString();
+            qWarning() << "TraversalFrontier: Cannot create spill file:" << m_error;
+            return false;
+        }
+    }
+
+    // The bottom half goes to disk; the top stays hot for the next pops.
+    const int count = m_entries.size() / 2;
+    const qint64 offset = m_spillFile->size();
+    m_spillFile->seek(offset);
+    QDataStream out(m_spillFile.data());
+    for (int i = 0; i < count; ++i) {
+        const Entry &entry = m_entries.at(i);
+        out << qint32(entry.depth) << entry.path;
+        m_memoryBytes -= entryCost(entry);
+    }
+    if (out.status() != QDataStream::Ok || !m_spillFile->flush()) {
+        m_error = m_spillFile->errorString();
+        qWarning() << "TraversalFrontier: Spill write failed:" << m_error;
+        for (int i = 0; i < count; ++i) m_memoryBytes += entryCost(m_entries.at(i));
+        m_spillFile->resize(offset);
+        return false;
+    }
+
+    m_entries.remove(0, count);
+    m_segmentOffsets.append(offset);
+    m_segmentCounts.append(count);
+    m_spilledCount += count;
+    ++m_spillCount;
+    return true;
+}
+
+bool TraversalFrontier::reload() {
+    if (m_segmentOffsets.isEmpty()) return false;
+
+    const qint64 offset = m_segmentOffsets.takeLast();
+    const qint64 count = m_segmentCounts.takeLast();
+    m_spillFile->seek(offset);
+    QDataStream in(m_spillFile.data());
+    m_entries.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        qint32 depth = 0;
+        Entry entry;
+        in >> depth >> entry.path;
+        if (in.status() != QDataStream::Ok) {
+            m_error = QStringLiteral("Corrupt frontier spill segment");
+            qWarning() << "TraversalFrontier: Spill read failed at segment offset" << offset << "-" << (count - i) << "entries lost";
+            m_lostCount += count - i;
+            break;
+        }
+        entry.depth = depth;
+        m_memoryBytes += entryCost(entry);
+        m_entries.append(std::move(entry));
+    }
+    m_spilledCount -= count;
+    m_spillFile->resize(offset); // The segment is consumed; keeps the file no larger than the live frontier
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef TRAVERSALFRONTIER_H
+#define TRAVERSALFRONTIER_H
+
+#include <QString>
+#include <QList>
+#include <QTemporaryFile>
+#include <QScopedPointer>
+
+// Explicit LIFO stack of directories still to visit, replacing recursion.
+// Entries are kept in memory up to a byte budget; past it, the oldest half of
+// the in-memory stack is appended to a temporary file as one segment. Segments
+// are read back (newest first) only once memory runs empty, so pop order is
+// exactly that of an unbounded stack and memory stays bounded whatever the
+// shape of the tree. A segment that cannot be read back is counted in
+// lostCount(); its directories are gone and the walk has to say so.
+class TraversalFrontier {
+public:
+    struct Entry {
+        QString path;
+        int depth = 0;
+    };
+
+    explicit TraversalFrontier(qint64 memoryLimitBytes = DEFAULT_MEMORY_LIMIT_BYTES);
+    ~TraversalFrontier();
+
+    void push(const QString &path, int depth);
+    bool pop(Entry &entry);             // False when empty
+    void clear();
+
+    bool isEmpty() const { return m_entries.isEmpty() && m_segmentOffsets.isEmpty(); }
+    qint64 size() const { return m_entries.size() + m_spilledCount; }
+    int spillCount() const { return m_spillCount; } // Segments written so far
+    bool hasError() const { return !m_error.isEmpty(); }
+    QString errorString() const { return m_error; }
+    qint64 lostCount() const { return m_lostCount; } // Entries a failed spill read dropped
+
+    static const qint64 DEFAULT_MEMORY_LIMIT_BYTES = 16 * 1024 * 1024;
+    static const qint64 MIN_MEMORY_LIMIT_BYTES = 64 * 1024;
+
+private:
+    static qint64 entryCost(const Entry &entry);
+    bool spill();
+    bool reload();                      // False when nothing is spilled
+
+    qint64 m_memoryLimit;
+    QList<Entry> m_entries;             // Top of stack at the back
+    qint64 m_memoryBytes;
+
+    QScopedPointer<QTemporaryFile> m_spillFile; // Created on the first spill
+    QList<qint64> m_segmentOffsets;     // Start of each segment; the last is the top
+    QList<qint64> m_segmentCounts;
+    qint64 m_spilledCount;
+    qint64 m_lostCount;
+    int m_spillCount;
+    QString m_error;
+};
+
+#endif // TRAVERSALFRONTIER_H
@@ -0,0 +1,143 @@
+#include "traversalstatistics.h"
+
+#include <QSettings>
+#include <QVariantMap>
+#include <QVariantList>
+#include <QDir>
+#include <algorithm>
+
+namespace {
+const QString STATISTICS_GROUP = QStringLiteral("TraversalStatistics");
+const QString KEY_PARENT_HITS = QStringLiteral("ParentHits");
+const QString KEY_DEPTH_HITS = QStringLiteral("DepthHits");
+const QString KEY_BARREN = QStringLiteral("BarrenDirectories");
+
+// Keeps the `limit` heaviest entries of a hash.
+template <typename T>
+void trimToLargest(QHash<QString, T> &hash, int limit) {
+    if (hash.size() <= limit) return;
+    QVector<T> values;
+    values.reserve(hash.size());
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it) values.append(it.value());
+    std::nth_element(values.begin(), values.begin() + (values.size() - limit), values.end());
+    const T cutoff = values.at(values.size() - limit);
+    for (auto it = hash.begin(); it != hash.end();) {
+        if (it.value() < cutoff) it = hash.erase(it);
+        else ++it;
+    }
+}
+}
+
+TraversalStatistics::TraversalStatistics()
+    : m_richnessDirty(true)
+{
+}
+
+QString TraversalStatistics::parentOf(const QString &path) {
+    auto isSeparator = [](QChar c) { return c == QLatin1Char('/') || c == QLatin1Char('\\'); };
+
+    qsizetype end = path.size();
+    while (end > 1 && isSeparator(path.at(end - 1))) --end;
+    qsizetype lastSeparator = end - 1;
+    while (lastSeparator >= 0 && !isSeparator(path.at(lastSeparator))) --lastSeparator;
+    if (lastSeparator < 0 || end <= 1) return QString();
+    if (lastSeparator == 0) return path.left(1);                            // "/"
+    if (path.at(lastSeparator - 1) == QLatin1Char(':')) return path.left(lastSeparator + 1); // "C:\"
+    return path.left(lastSeparator);
+}
+
+TraversalStatistics TraversalStatistics::load(QSettings &settings) {
+    TraversalStatistics stats;
+    settings.beginGroup(STATISTICS_GROUP);
+    const QVariantMap parentHits = settings.value(KEY_PARENT_HITS).toMap();
+    for (auto it = parentHits.cbegin(); it != parentHits.cend(); ++it) stats.m_parentHits.insert(it.key(), it.value().toDouble());
+    const QVariantList depthHits = settings.value(KEY_DEPTH_HITS).toList();
+    for (const QVariant &value : depthHits) stats.m_depthHits.append(value.toDouble());
+    const QVariantMap barren = settings.value(KEY_BARREN).toMap();
+    for (auto it = barren.cbegin(); it != barren.cend(); ++it) stats.m_barrenCounts.insert(it.key(), it.value().toInt());
+    settings.endGroup();
+    return stats;
+}
+
+void TraversalStatistics::save(QSettings &settings) const {
+    QHash<QString, double> parentHits = m_parentHits;
+    trimToLargest(parentHits, MAX_PARENT_ENTRIES);
+    QHash<QString, int> barrenCounts = m_barrenCounts;
+    trimToLargest(barrenCounts, MAX_BARREN_ENTRIES);
+
+    QVariantMap parentMap;
+    for (auto it = parentHits.cbegin(); it != parentHits.cend(); ++it) parentMap.insert(it.key(), it.value());
+    QVariantList depthList;
+    for (double weight : m_depthHits) depthList.append(weight);
+    QVariantMap barrenMap;
+    for (auto it = barrenCounts.cbegin(); it != barrenCounts.cend(); ++it) barrenMap.insert(it.key(), it.value());
+
+    settings.beginGroup(STATISTICS_GROUP);
+    settings.setValue(KEY_PARENT_HITS, parentMap);
+    settings.setValue(KEY_DEPTH_HITS, depthList);
+    settings.setValue(KEY_BARREN, barrenMap);
+    settings.endGroup();
+}
+
+void TraversalStatistics::recordHit(const QString &projectPath, int depth, double weight) {
+    const QString parent = parentOf(QDir::toNativeSeparators(projectPath));
+    if (!parent.isEmpty()) m_parentHits[parent] += weight;
+    // Keep the ancestor sums current instead of rebuilding them on the next
+    // richness() lookup: a scan records hits between lookups all along.
+    if (!m_richnessDirty) {
+        for (QString dir = parent; !dir.isEmpty(); dir = parentOf(dir)) m_richness[dir] += weight;
+    }
+    if (depth >= 0 && depth < MAX_TRACKED_DEPTH) {
+        if (m_depthHits.size() <= depth) m_depthHits.resize(depth + 1, 0.0);
+        m_depthHits[depth] += weight;
+    }
+    // Anything above a hit is no longer barren.
+    for (QString dir = parent; !dir.isEmpty() && !m_barrenCounts.isEmpty(); dir = parentOf(dir)) m_barrenCounts.remove(dir);
+}
+
+void TraversalStatistics::recordBarren(const QString &directoryPath) {
+    m_barrenCounts[directoryPath]++;
+}
+
+void TraversalStatistics::decay() {
+    for (auto it = m_parentHits.begin(); it != m_parentHits.end();) {
+        it.value() *= DECAY_FACTOR;
+        if (it.value() < MIN_WEIGHT) it = m_parentHits.erase(it);
+        else ++it;
+    }
+    for (double &weight : m_depthHits) weight *= DECAY_FACTOR;
+    m_richnessDirty = true;
+}
+
+void TraversalStatistics::rebuildRichness() const {
+    m_richness.clear();
+    for (auto it = m_parentHits.cbegin(); it != m_parentHits.cend(); ++it) {
+        for (QString dir = it.key(); !dir.isEmpty(); dir = parentOf(dir)) m_richness[dir] += it.value();
+    }
+    m_richnessDirty = false;
+}
+
+double TraversalStatistics::richness(const QString &directoryPath) const {
+    if (m_parentHits.isEmpty()) return 0.0;
+    if (m_richnessDirty) rebuildRichness();
+    return m_richness.value(directoryPath, 0.0);
+}
+
+bool TraversalStatistics::isBarren(const QString &directoryPath) const {
+    return m_barrenCounts.value(directoryPath, 0) >= BARREN_THRESHOLD;
+}
+
+int TraversalStatistics::suggestedQuickDepth(int defaultDepth, int maxDepth) const {
+    double total = 0.0;
+    for (double weight : m_depthHits) total += weight;
+    if (total < MIN_DEPTH_SAMPLES) return defaultDepth;
+
+    // Smallest Quick Scan limit that would have reached most past hits; heuristics
+    // run on depths below the limit, so a hit at depth N needs a limit of N + 1.
+    double covered = 0.0;
+    for (int depth = 0; depth < m_depthHits.size(); ++depth) {
+        covered += m_depthHits.at(depth);
+        if (covered >= total * DEPTH_COVERAGE) return qBound(defaultDepth, depth + 1, maxDepth);
+    }
+    return qBound(defaultDepth, int(m_depthHits.size()), maxDepth);
+}
@@ -0,0 +1,56 @@
+#ifndef TRAVERSALSTATISTICS_H
+#define TRAVERSALSTATISTICS_H
+
+#include <QString>
+#include <QHash>
+#include <QVector>
+
+class QSettings;
+
+// Lightweight memory of where Softudio projects turned up in past scans and
+// imports.
+// Keeps decayed hit weights per parent directory, a histogram of the depths
+// (below the scan root) hits were found at, and shallow directories that
+// complete scans found empty. ScanWorker uses it to visit known-rich subtrees
+// first, let Quick Scan go deeper under them, and push barren ones back.
+// A plain value type: each thread works on its own copy.
+class TraversalStatistics {
+public:
+    TraversalStatistics();
+
+    static TraversalStatistics load(QSettings &settings);
+    void save(QSettings &settings) const;
+
+    void recordHit(const QString &projectPath, int depth, double weight = SCAN_HIT_WEIGHT); // depth < 0: unknown
+    void recordBarren(const QString &directoryPath);
+    void decay();                               // Once per scan, before its hits are recorded
+
+    bool isEmpty() const { return m_parentHits.isEmpty() && m_barrenCounts.isEmpty(); }
+    double richness(const QString &directoryPath) const; // Hit weight at or below the directory
+    bool isBarren(const QString &directoryPath) const;
+    int suggestedQuickDepth(int defaultDepth, int maxDepth) const;
+
+    static QString parentOf(const QString &path); // Native separators; empty for a root
+
+    static constexpr double SCAN_HIT_WEIGHT = 1.0;
+    static constexpr double IMPORT_HIT_WEIGHT = 3.0;    // The user kept it: a stronger signal
+    static constexpr double DECAY_FACTOR = 0.9;
+    static constexpr double MIN_WEIGHT = 0.05;          // Decayed below this: forgotten
+    static const int MAX_PARENT_ENTRIES = 512;
+    static const int MAX_BARREN_ENTRIES = 1024;
+    static const int MAX_TRACKED_DEPTH = 32;
+    static const int BARREN_THRESHOLD = 2;              // Consecutive empty scans before deprioritizing
+    static const int MIN_DEPTH_SAMPLES = 5;
+    static constexpr double DEPTH_COVERAGE = 0.9;       // suggestedQuickDepth covers this share of hits
+
+private:
+    void rebuildRichness() const;
+
+    QHash<QString, double> m_parentHits;
+    QVector<double> m_depthHits;                // Index: depth below the scan root
+    QHash<QString, int> m_barrenCounts;
+    mutable QHash<QString, double> m_richness;  // Parent hits summed onto every ancestor
+    mutable bool m_richnessDirty;
+};
+
+#endif // TRAVERSALSTATISTICS_H